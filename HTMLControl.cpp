@@ -28,6 +28,7 @@
 #include "sgml.h"
 #include "cmp_nocase.h"
 #include "istr.h"
+#include "scan.h"
 
 #ifndef nelems
 #define nelems(array) (sizeof(array) / sizeof((array)[0]))
@@ -40,6 +41,21 @@ enum {
 	NON_CONTAINER_TAG
 };
 
+/*
+ * Return the number of characters from p up to end.
+ */
+static int
+count_columns(const unsigned char *p, const unsigned char *end)
+{
+	int n = 0;
+
+	for (; p < end; p++) {
+		if ((*p & 0xC0) != 0x80)
+			n++;
+	}
+	return n;
+}
+
 void
 HTMLControl::htmlparser_yyerror(const char *p)
 {
@@ -56,12 +72,58 @@ HTMLControl::htmlparser_yyerror(const char *p)
 		<< "\", line "
 		<< current_line
 		<< ", column "
-		<< current_column
+		<< current_column + count_columns(linestart, chars)
 		<< ": "
 		<< p
 		<< std::endl;
 }
 
+/*
+ * A PCDATA token either has text of its own, or is a view of the input
+ * for as long as it needs no changes.  Where these index the view it is
+ * by byte rather than by character, which is the same to whitespace.
+ */
+static size_t
+pcdata_length(const PCData *d)
+{
+	return d->view != NULL ? d->viewlen : d->text.length();
+}
+
+static int
+pcdata_at(const PCData *d, size_t i)
+{
+	return d->view != NULL ? d->view[i] : d->text[i];
+}
+
+/*
+ * Keep only the part of the text from "from" up to "to".
+ */
+static void
+pcdata_trim(PCData *d, size_t from, size_t to)
+{
+	if (d->view != NULL) {
+		d->view += from;
+		d->viewlen = to - from;
+	} else {
+		d->text.erase(to);
+		d->text.erase(0, from);
+	}
+}
+
+/*
+ * Return whether collapsing whitespace changes the len bytes at p.
+ */
+static bool
+needs_collapse(const unsigned char *p, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (isspace(p[i]) &&
+				(p[i] != ' ' || (i + 1 < len && isspace(p[i + 1]))))
+			return true;
+	}
+	return false;
+}
+
 /*
  * Effectively, this method simply invokes "yylex2()", but it does some
  * postprocessing on PCDATA tokens that would be difficult to do in "yylex2()".
@@ -72,8 +134,16 @@ int HTMLControl::htmlparser_yylex(
 	for (;;) { // Notice the "return" at the end of the body!
 		int token, tag_type;
 
-		if (next_token == EOF) {
+		if (held_token != EOF) {
+			/* pushed input ran out looking ahead of this one */
+			token = held_token;
+			*value_return = held_token_value;
+			tag_type = held_token_tag_type;
+			held_token = EOF;
+		} else if (next_token == EOF) {
 			token = yylex2(value_return, &tag_type);
+			if (token == NEED_INPUT)
+				return token;
 		} else {
 			token = next_token;
 			*value_return = next_token_value;
@@ -85,13 +155,18 @@ int HTMLControl::htmlparser_yylex(
 		if (token == HTMLParser_token::PRE) {
 			literal_mode = true;
 
-			if (next_token == EOF)
-				next_token = yylex2(&next_token_value, &next_token_tag_type);
+			if (!look_ahead()) {
+				held_token = token;
+				held_token_value = *value_return;
+				held_token_tag_type = tag_type;
+				return NEED_INPUT;
+			}
 			if (next_token == HTMLParser_token::PCDATA) {
 				/* Swallow '\n' immediately following "<PRE>" */
-				istr &s(*next_token_value.strinG);
-				if (!s.empty() && s[0] == '\n')
-					s.erase(0, 1);
+				PCData *d = next_token_value.pcdata;
+				size_t len = pcdata_length(d);
+				if (len > 0 && pcdata_at(d, 0) == '\n')
+					pcdata_trim(d, 1, len);
 			}
 		}
 
@@ -99,19 +174,24 @@ int HTMLControl::htmlparser_yylex(
 			literal_mode = false;
 
 		if (token == HTMLParser_token::PCDATA) {
+			PCData *d = value_return->pcdata;
+
 			/* In order to post-process the PCDATA token, we need to
 			 * look ahead one token...  */
-			if (next_token == EOF)
-				next_token = yylex2(&next_token_value, &next_token_tag_type);
+			if (!look_ahead()) {
+				held_token = token;
+				held_token_value = *value_return;
+				held_token_tag_type = tag_type;
+				return NEED_INPUT;
+			}
 
 			/* Erase " '\n' { ' ' } " immediately before "</PRE>".  */
 			if (next_token == HTMLParser_token::END_PRE) {
-				istr &s(*value_return->strinG);
-				string::size_type x = s.length();
-				while (x > 0 && s[x - 1] == ' ')
+				size_t x = pcdata_length(d);
+				while (x > 0 && pcdata_at(d, x - 1) == ' ')
 					--x;
-				if (x > 0 && s[x - 1] == '\n')
-					s.erase(x - 1, string::npos);
+				if (x > 0 && pcdata_at(d, x - 1) == '\n')
+					pcdata_trim(d, 0, x - 1);
 			}
 			/* Erase whitespace before end tag or block start tag. */
 			else if (!literal_mode && (
@@ -120,26 +200,25 @@ int HTMLControl::htmlparser_yylex(
 					next_token_tag_type == BLOCK_START_TAG
 					))
 			{
-				istr &s(*value_return->strinG);
-				string::size_type x = s.length();
-				while (x > 0 && isspace(s[x - 1]))
+				size_t x = pcdata_length(d);
+				while (x > 0 && isspace(pcdata_at(d, x - 1)))
 					--x;
-				s.erase(x, string::npos);
+				pcdata_trim(d, 0, x);
 			}
 
 			/* Collate sequences of whitespace, if not in "literal mode". */
 			if (!literal_mode) {
-				istr &s(*value_return->strinG);
-				for (string::size_type x = 0; x < s.length(); ++x) {
-					if (isspace(s[x])) {
-						string::size_type y;
-						for (y = x + 1; y < s.length() && isspace(s[y]); ++y)
-							;
-						s.replace(x, y - x, " ");
-					}
+				/* a view only needs a copy if it changes */
+				if (d->view != NULL &&
+						needs_collapse(d->view, d->viewlen))
+				{
+					d->text.append(d->view, d->viewlen);
+					d->view = NULL;
 				}
-				if (s.empty()) {
-					delete value_return->strinG;
+				if (d->view == NULL)
+					d->text.collapse_space();
+				if (pcdata_length(d) == 0) {
+					delete d;
 					continue;
 				}
 			}
@@ -159,17 +238,22 @@ int HTMLControl::htmlparser_yylex(
 				 token != HTMLParser_token::STYLE
 				))
 		{
-			if (next_token == EOF)
-				next_token = yylex2(&next_token_value, &next_token_tag_type);
+			if (!look_ahead()) {
+				held_token = token;
+				held_token_value = *value_return;
+				held_token_tag_type = tag_type;
+				return NEED_INPUT;
+			}
 			if (next_token == HTMLParser_token::PCDATA) {
-				istr &s(*next_token_value.strinG);
-				string::size_type x;
-				for (x = 0; x < s.length() && isspace(s[x]); ++x)
+				PCData *d = next_token_value.pcdata;
+				size_t len = pcdata_length(d);
+				size_t x;
+				for (x = 0; x < len && isspace(pcdata_at(d, x)); ++x)
 					;
 				if (x > 0)
-					s.erase(0, x);
-				if (s.empty()) {
-					delete next_token_value.strinG;
+					pcdata_trim(d, x, len);
+				if (x == len) {
+					delete d;
 					next_token = EOF;
 				}
 			}
@@ -180,13 +264,30 @@ int HTMLControl::htmlparser_yylex(
 }
 
 /*
- * Keep this array sorted alphabetically!
+ * Scan the token after the current one into next_token, unless that
+ * was done already, returns false when pushed input ran out first.
  */
-static const struct TextToIntP {
+bool
+HTMLControl::look_ahead()
+{
+	if (next_token == EOF)
+		next_token = yylex2(&next_token_value, &next_token_tag_type);
+	if (next_token != NEED_INPUT)
+		return true;
+	next_token = EOF;
+	return false;
+}
+
+/*
+ * The recognised tags, looked up through the perfect hash below.  The
+ * order does not matter for the lookup, but keep it alphabetical.
+ * Names must be upper case, the hash folds the scanned name to match.
+ */
+static constexpr struct TextToIntP {
 	char name[11];
 	char block_tag;
-	const int start_tag_code;
-	const int end_tag_code;
+	int start_tag_code;
+	int end_tag_code;
 }
 tag_names[] = {
 #define pack1(tag) \
@@ -266,411 +367,1095 @@ tag_names[] = {
 #undef pack
 };
 
-int
-HTMLControl::yylex2(html2text::HTMLParser::semantic_type *value_return,
-		int *tag_type_return)
+/*
+ * The attribute names, indexed by their AttributeName.
+ */
+static constexpr char attr_names[][9] = {
+	"ALIGN",
+	"ALT",
+	"BORDER",
+	"CHECKED",
+	"CODE",
+	"COLSPAN",
+	"HREF",
+	"MULTIPLE",
+	"NAME",
+	"ROWSPAN",
+	"SIZE",
+	"SRC",
+	"STYLE",
+	"TYPE",
+	"VALIGN",
+	"VALUE",
+	"WIDTH",
+};
+
+static_assert(nelems(attr_names) == ATTR_UNKNOWN,
+		"attr_names[] does not match enum AttributeName");
+
+/*
+ * Tags and attribute names are looked up through a perfect hash: a
+ * seeded 32-bits FNV-1a hash over the case folded name, of which the
+ * top byte selects a slot.  The seed of each table was searched for
+ * such that no two of its names share a slot, which the static_asserts
+ * below verify at compile time: when adding a name breaks it, search
+ * for another seed.
+ */
+struct TagTable {
+	static constexpr size_t count = nelems(tag_names);
+	static constexpr unsigned int seed = 15696u;
+	static constexpr unsigned int slots = 256;
+	static constexpr const char *name(size_t i)
+	{
+		return tag_names[i].name;
+	}
+};
+
+struct AttrTable {
+	static constexpr size_t count = nelems(attr_names);
+	static constexpr unsigned int seed = 270u;
+	static constexpr unsigned int slots = 32;
+	static constexpr const char *name(size_t i)
+	{
+		return attr_names[i];
+	}
+};
+
+static constexpr unsigned char
+name_fold(unsigned char c)
 {
-	int c;
+	return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+}
 
-	*tag_type_return = NOT_A_TAG;
-	for (;;) { // Notice the "return" at the end of this loop.
-		/*
-		 * Get the first character of the token.
-		 */
-		c = get_char();
-		if (c == EOF)
-			return EOF;
+static constexpr unsigned int
+name_hash(const char *s, size_t len, unsigned int h)
+{
+	return len == 0 ? h :
+		name_hash(s + 1, len - 1,
+				(h ^ name_fold((unsigned char)*s)) * 16777619u);
+}
 
-		if (c == '<') {
-			/*
-			 * Examine the first character of the tag.
-			 */
-			c = get_char();
-			if (c == '!') {
-				c = get_char();
-				if (c == '-') {
-					c = get_char();
-					if (c != '-')
-						return HTMLParser_token::SCAN_ERROR;
-
-					/*
-					 * This is a comment... skip it!
-					 *
-					 *   <!-- Single-line comment -->
-					 *
-					 *   <!-- Multi-
-					 *        line
-					 *        comment //-->
-					 *
-					 * EXTENSION: Allow "-->" as the terminator of a
-					 *            multi-line comment.
-					 */
-					int state = 0;
-					do {
-						c = get_char();
-						if (c == EOF)
-							return HTMLParser_token::SCAN_ERROR;
-						switch (state) {
-						case 0: if (c == '-')
-								state = 1;
-						break;
-						case 1: state = c == '-' ? 2 : 0;
-							break;
-						case 2: state = c == '>' ? 3 : c == '-' ? 2 : 0;
-							break;
-						}
-					} while (state != 3);
-					continue; // Start over
-				}
+static constexpr size_t
+name_len(const char *s)
+{
+	return *s == '\0' ? 0 : 1 + name_len(s + 1);
+}
 
-				/* scan <![if .... ]> <![endif]> kind of crap */
-				if (c == '[') {
-					do {
-						c = get_char();
-						if (c == EOF)
-							return HTMLParser_token::SCAN_ERROR;
-					} while (c != ']');
-					do {
-						c = get_char();
-					} while (c != EOF && isspace(c));
-					if (c != '>')
-						return HTMLParser_token::SCAN_ERROR;
-					continue;  /* ignore this thing (start over) */
-				}
+static constexpr bool
+name_upper(const char *s)
+{
+	return *s == '\0' ||
+		(name_fold((unsigned char)*s) == *s && name_upper(s + 1));
+}
 
-				/*
-				 * Scan "<!DOCTYPE ...>" tag.
-				 */
-				if (!isalpha(c))
-					return HTMLParser_token::SCAN_ERROR;
-				string tag_name(1, '!');
-				tag_name += c;
-				for (;;) {
-					c = get_char();
-					if (!isalnum(c) && c != '-')
-						break;
-					tag_name += c;
-				}
-				if (cmp_nocase(tag_name, "!DOCTYPE") != 0)
-					return HTMLParser_token::SCAN_ERROR;
-				while (c != '>') {
-					c = get_char();
-					if (c == EOF)
-						return HTMLParser_token::SCAN_ERROR;
-					// Let newline not close the DOCTYPE tag - Arno
-				}
-				return HTMLParser_token::DOCTYPE;
+template<class T> constexpr unsigned int
+name_slot(const char *s, size_t len)
+{
+	return (name_hash(s, len, T::seed) >> 24) % T::slots;
+}
+
+/* the (first) entry of the table hashing to slot, or -1 */
+template<class T> constexpr int
+slot_owner(unsigned int slot, size_t i = 0)
+{
+	return i == T::count ? -1 :
+		name_slot<T>(T::name(i), name_len(T::name(i))) == slot ?
+		(int)i : slot_owner<T>(slot, i + 1);
+}
+
+/* expand the slots from the slot numbers 0 .. T::slots - 1 */
+template<class T, unsigned int... S> struct HashSlots {
+	static constexpr signed char slots[sizeof...(S)] = {
+		(signed char)slot_owner<T>(S)...
+	};
+};
+template<class T, unsigned int... S>
+constexpr signed char HashSlots<T, S...>::slots[sizeof...(S)];
+
+template<class T, unsigned int N, unsigned int... S> struct MakeHashSlots :
+	MakeHashSlots<T, N - 1, N - 1, S...> {};
+template<class T, unsigned int... S> struct MakeHashSlots<T, 0, S...> :
+	HashSlots<T, S...> {};
+
+template<class T> constexpr bool
+hash_perfect(size_t i = 0)
+{
+	return i == T::count ||
+		(MakeHashSlots<T, T::slots>::slots[name_slot<T>(T::name(i),
+			name_len(T::name(i)))] == (signed char)i &&
+		 name_upper(T::name(i)) &&
+		 hash_perfect<T>(i + 1));
+}
+
+static_assert(TagTable::count < 128 && AttrTable::count < 128,
+		"hash slots store table indices as signed char");
+static_assert(hash_perfect<TagTable>(),
+		"tag_names[] has names sharing a hash slot or not in upper case, "
+		"change TagTable::seed");
+static_assert(hash_perfect<AttrTable>(),
+		"attr_names[] has names sharing a hash slot or not in upper case, "
+		"change AttrTable::seed");
+
+/*
+ * Return the index in table T of the len bytes of name, or -1.
+ */
+template<class T> static int
+lookup_name(const unsigned char *name, size_t len)
+{
+	int i = MakeHashSlots<T, T::slots>::slots[
+		name_slot<T>((const char *)name, len)];
+
+	if (i < 0 || _cmp_nocase(T::name(i), name_len(T::name(i)),
+				(const char *)name, len) != 0)
+		return -1;
+	return i;
+}
+
+/*
+ * Count the characters of text at p up to max, text ends where a tag
+ * starts.  Returns -1 when end comes before that is known.
+ */
+static int
+text_chars(const unsigned char *p, const unsigned char *end, bool eof,
+		int max)
+{
+	int n;
+
+	for (n = 0; n < max; n++) {
+		if (p == end)
+			return eof ? n : -1;
+		if (*p == '<') {
+			if (p + 1 == end) {
+				if (!eof)
+					return -1;
+			} else if (p[1] == '!' || p[1] == '/' || isalpha(p[1])) {
+				return n;
 			}
+		}
+		for (p++; p < end && (*p & 0xC0) == 0x80; p++)
+			;
+	}
+	return n;
+}
 
-			if (c == '/' || isalpha(c) || c == '_') {
-				string tag_name;
-				bool is_end_tag = false;
+/*
+ * Codes scan_markup() returns besides tokens, NEED_MORE means the
+ * window ended before the markup did.
+ */
+enum {
+	LITERAL = -7,
+	MARKED_SECTION,
+	COMMENT,
+	SWALLOWED,
+	NEED_MORE
+};
 
-				if (c == '/') {
-					is_end_tag = true;
-					c = get_char();
-				}
-				if (!isalpha(c) && c != '_')
-					return HTMLParser_token::SCAN_ERROR;
-				tag_name += c;
-				for (;;) {
-					c = get_char();
-					/* ID and NAME tokens must begin with a letter
-					 * ([A-Za-z]) -- isalpha tested before -- and may be
-					 * followed by any number of letters, digits
-					 * ([0-9]), hyphens ("-"), underscores ("_"), colons
-					 * (":"), and periods (".") */
-					if (!isalnum(c) &&
-							c != '-' && c != '_' && c != ':' && c != '.')
-						break;
-					tag_name += c;
-				}
+int
+HTMLControl::yylex2(html2text::HTMLParser::semantic_type *value_return,
+		int *tag_type_return)
+{
+	*tag_type_return = NOT_A_TAG;
+	for (;;) { // Notice the "return" at the end of this loop.
+		const unsigned char *p;
+		int token;
 
-				while (isspace(c))
-					c = get_char();
-
-				/*
-				 * Scan tag attributes (only for opening tags). Create
-				 * the "tag_attributes" only on demand; this saves a lot
-				 * of overhead.
-				 */
-				auto_ptr<list<TagAttribute> > tag_attributes;
-				if (!is_end_tag) {
-					while (isalpha(c) || c == '_') {
-						TagAttribute attribute;
-
-						/* Scan attribute name, see the ID and NAME rule
-						 * mentioned above */
-						attribute.first = c;
-						for (;;) {
-							c = get_char();
-							if (!isalnum(c) &&
-									c != '-' && c != '_' &&
-									c != ':' && c != '.')
-								break;
-							attribute.first += c;
-						}
-
-						while (isspace(c))
-							c = get_char();    // Skip WS after attribute name
-
-						/*
-						 * Scan (optional) attribute value.
-						 */
-						if (c == '=') {
-							c = get_char();
-							while (isspace(c))
-								c = get_char();
-							if (c == '"' || c == '\'') {
-								int closing_quote = c; // Same as opening quote!
-								for (;;) {
-									c = get_char();
-									if (c == EOF)
-										return HTMLParser_token::SCAN_ERROR;
-									// Accept multiple-line elements - Arno
-									if (c == closing_quote)
-										break;
-
-									/*
-									 * Do *not* interpret "&auml;" and
-									 * consorts here! This would ruin
-									 * tag attributes like
-									 * "HREF=hhh?a=1&b=2".
-									 */
-									attribute.second += c;
-								}
-								c = get_char(); // Get next after closing quote
-							} else {
-								while (c != '>' && c > ' ') {
-									// This is for non-ACSII chars - Arno
-									if (c == EOF)
-										return HTMLParser_token::SCAN_ERROR;
-									// Same as in line 390
-									attribute.second += c;
-									c = get_char();
-								}
-							}
-
-							while (isspace(c))
-								c = get_char();    // Skip WS after attr value
-						} else {
-							/* if we get something malformed like
-							 * att:"bla" (colon iso =), ensure we eat
-							 * away the garbage until space or closing
-							 * tag */
-							while (!isspace(c) && c != '>')
-								c = get_char();
-							while (isspace(c))
-								c = get_char();
-						}
-
-						/*
-						 * Store the attribute.
-						 */
-						if (!tag_attributes.get()) {
-							tag_attributes.reset(new list<TagAttribute>);
-						}
-						tag_attributes->push_back(attribute);
-					}
-				}
+		if (handler != NULL && handler->stop)
+			return EOF;
 
-				// accept XHTML tags like <hr /> - Alexander Solovey
+		/* carry on with what pushed input ran out in last time */
+		if (skipping != 0) {
+			bool ok = skipping == COMMENT ?
+				skip_comment() : skip_marked_section();
 
-				if (c != '>') {
-					if (c == '/') {
-						c = get_char();
-						if (c != '>') {
-							return HTMLParser_token::SCAN_ERROR;
-						}
-					} else {
-						return HTMLParser_token::SCAN_ERROR;
-					}
-				}
+			if (!ok && starving)
+				return NEED_INPUT;
+			if (ok && skipping == COMMENT && handler != NULL)
+				handler->comment(handler_buf.data(),
+						handler_buf.length());
+			skipping = 0;
+			if (!ok)
+				return HTMLParser_token::SCAN_ERROR;
+			continue; // Start over
+		}
+		if (partial != NULL) {
+			token = scan_pcdata(value_return);
+			if (token == SWALLOWED)
+				continue;
+			return token;
+		}
 
-				if (debug_scanner) {
-					std::cerr << "Scanned tag \"<" <<
-						(is_end_tag ? "/" : "") << tag_name;
-					if (!is_end_tag && tag_attributes.get()) {
-						const list<TagAttribute>           &ta(*tag_attributes);
-						list<TagAttribute>::const_iterator j;
-						for (j = ta.begin(); j != ta.end(); ++j) {
-							std::cerr << " " << (*j).first <<
-								"=\"" << (*j).second.c_str() << "\"";
-						}
-					}
-					std::cerr << ">\"" << std::endl;
-				}
+		if (chars == charsend && !fill_chars(chars))
+			return starving ? NEED_INPUT : EOF;
 
-				/*
-				 * Look up the tag in the table of recognized tags.
-				 */
-				static int(*const f)(const char *, const char *) = cmp_nocase;
-				const TextToIntP *tag = (const TextToIntP *) bsearch(
-						tag_name.c_str(),
-						tag_names, nelems(tag_names), sizeof(TextToIntP),
-						(int (*)(const void *, const void *))f);
-				if (tag == NULL) { /* EXTENSION: Swallow unknown tags. */
-					if (debug_scanner) {
-						std::cerr << "Tag unknown -- swallowed." << std::endl;
-					}
-					continue;
-				}
+		if (*chars == '<') {
+			/* markup that continues past the window is scanned
+			 * further once the window is extended */
+			for (;;) {
+				p = chars;
+				token = scan_markup(p, value_return, tag_type_return);
+				if (token != NEED_MORE)
+					break;
+				if (!fill_chars(chars) && starving)
+					return NEED_INPUT;
+			}
 
-				/*
-				 * Return the BISON token code for the tag.
-				 */
-				if (is_end_tag) {
-					if (!tag->end_tag_code) {
-						if (debug_scanner) {
-							std::cerr << "Non-container end tag scanned." <<
-								std::endl;
-						}
-						continue;
-					}
-					*tag_type_return = tag->block_tag ? BLOCK_END_TAG : END_TAG;
-					return tag->end_tag_code;
-				} else {
-					*tag_type_return = (
-						!tag->end_tag_code ? NON_CONTAINER_TAG :
-						tag->block_tag     ? BLOCK_START_TAG   : START_TAG
-						);
-					value_return->tag_attributes = tag_attributes.release();
-					return tag->start_tag_code;
+			if (token != LITERAL) {
+				if (discard)
+					count_discarded(token, p - chars);
+				advance(p);
+				switch (token) {
+				case COMMENT:
+				case MARKED_SECTION:
+					/* ignore this thing (start over) */
+					skipping = token;
+					marked_closed = false;
+					handler_buf.clear();
+					continue;
+				case SWALLOWED:
+					continue;
 				}
+				return token;
 			}
 
 			/*
 			 * EXTENSION: This tag did not match "<!", and not "</", and not
 			 * "<[A-Za-z-]", so take it as literal text.
 			 */
-			unget_char(c);
-			c = '<';
+		} else if (*chars != '\n' && *chars < ' ') {
+			advance(chars + 1);
+			return HTMLParser_token::SCAN_ERROR;
 		}
 
-		if (c == '\n' || (unsigned char) c >= (unsigned char) ' ') {
-			// Same as in line 402
-			istr *s = value_return->strinG = new istr;
-
-			while (c != EOF) {
-				/*
-				 * Accept literal '<' in some cases.
-				 */
-				if (c == '<') {
-					int c2;
-					unget_char(c2 = get_char());
-					if (c2 == '!' || c2 == '/' || isalpha(c2)) {
-						unget_char(c);
-						break;
+		partial = handler != NULL ? &handler_text : new PCData;
+	}
+}
+
+/*
+ * Collect the text that starts at chars into the PCDATA token in
+ * partial.  Returns SWALLOWED if it turns out empty.
+ */
+int
+HTMLControl::scan_pcdata(html2text::HTMLParser::semantic_type *value_return)
+{
+	PCData *d = partial;
+	istr *s = &d->text;
+	bool done = false;
+	const unsigned char *p;
+
+	do {
+		p = chars;
+		for (;;) {
+			p = scan_text(p, charsend);
+			if (p == charsend)
+				break;
+			if (*p == '\n') {
+				current_line++;
+				current_column = 0;
+				linestart = ++p;
+				continue;
+			}
+			if (*p == '&') {
+				/* Replace "&auml;" and consorts right here, an
+				 * entity needs four characters of text to fit */
+				int avail = text_chars(p, charsend, charseof, 4);
+				size_t n = 0;
+				int c;
+
+				if (avail >= 4) {
+					n = decode_sgml_entity(p, charsend, charseof, &c);
+				} else if (avail >= 0) {
+					n = 1;
+					c = EOF;
+				}
+				if (n == 0)
+					break;  /* decide once we know what follows */
+				p += n;
+				if (c == EOF) {
+					/* the character after the '&' is taken
+					 * along, which may be a newline */
+					if (p[-1] == '\n') {
+						current_line++;
+						current_column = 0;
+						linestart = p;
 					}
+					continue;
 				}
-
+				s->append(chars, p - n - chars);
 				*s += c;
-				c = get_char();
+				chars = p;
+				continue;
 			}
 
-			/* need to do this here, because space calculations want to
-			 * know the final form of the data */
-			replace_sgml_entities(s); // Replace "&auml;" and consorts.
-
 			/*
-			 * Swallow empty PCDATAs.
+			 * Accept literal '<' in some cases.
 			 */
-			if (s->empty()) {
-				delete s;
-				continue;
+			if (p + 1 == charsend) {
+				/* decide once we know what follows */
+				if (charseof)
+					p = charsend;
+				break;
+			}
+			if (p[1] == '!' || p[1] == '/' || isalpha(p[1])) {
+				done = true;
+				break;
 			}
+			p++;
+		}
+		/* text that is in the input as is, and in one piece,
+		 * can stay there */
+		if (s->empty() && (done || charseof) &&
+				is.span_retained(chars))
+		{
+			d->view = chars;
+			d->viewlen = p - chars;
+		} else {
+			s->append(chars, p - chars);
+		}
+		chars = p;
+	} while (!done &&
+			(fill_chars(chars) || (!starving && chars != charsend)));
 
-			if (debug_scanner)
-				std::cerr << "Scanned PCDATA \"" << s->c_str() << "\""
-					<< std::endl;
+	/* the rest of the text is yet to be pushed */
+	if (!done && starving)
+		return NEED_INPUT;
+	partial = NULL;
 
-			return HTMLParser_token::PCDATA;
+	if (d == &handler_text) {
+		if (d->view != NULL) {
+			handler->text((const char *)d->view, d->viewlen);
+		} else if (!s->empty()) {
+			const string &t = s->str();
+			handler->text(t.data(), t.length());
 		}
+		s->erase();
+		d->view = NULL;
+		return SWALLOWED;
+	}
 
-		return HTMLParser_token::SCAN_ERROR;
+	/*
+	 * Swallow empty PCDATAs.
+	 */
+	if (pcdata_length(d) == 0) {
+		delete d;
+		return SWALLOWED;
+	}
+
+	if (debug_scanner) {
+		std::cerr << "Scanned PCDATA \"";
+		if (d->view != NULL)
+			std::cerr.write((const char *)d->view, d->viewlen);
+		else
+			std::cerr << s->c_str();
+		std::cerr << "\"" << std::endl;
 	}
+
+	value_return->pcdata = d;
+	return HTMLParser_token::PCDATA;
 }
 
-bool
-HTMLControl::read_cdata(const char *terminal, string *value_return)
+/*
+ * Tags are scanned by a DFA over character classes.  The classes of
+ * the bytes are in char_classes[], UTF-8 lead bytes are CC_OTHER, and
+ * the end of the input is CC_EOF.  Names follow the ID and NAME rule:
+ * they must begin with a letter ([A-Za-z]) -- or an underscore, as an
+ * extension -- and may be followed by any number of letters, digits
+ * ([0-9]), hyphens ("-"), underscores ("_"), colons (":"), and periods
+ * (".").
+ */
+enum CharClass {
+	CC_OTHER,
+	CC_SPACE,       /* as isspace() */
+	CC_CONTROL,     /* the other characters below ' ' */
+	CC_NAME_START,  /* [A-Za-z_] */
+	CC_NAME,        /* [0-9:.-] */
+	CC_EQUALS,
+	CC_QUOTE,
+	CC_SLASH,
+	CC_GT,
+	CC_EOF,
+	CC_COUNT
+};
+
+static constexpr unsigned char
+char_class(unsigned int c)
 {
-	string &s(*value_return);
+	return
+		c == ' ' || (c >= '\t' && c <= '\r') ? CC_SPACE   :
+		c < ' '                              ? CC_CONTROL :
+		(c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' ?
+		                                       CC_NAME_START :
+		(c >= '0' && c <= '9') || c == '-' || c == ':' || c == '.' ?
+		                                       CC_NAME    :
+		c == '='                             ? CC_EQUALS  :
+		c == '"' || c == '\''                ? CC_QUOTE   :
+		c == '/'                             ? CC_SLASH   :
+		c == '>'                             ? CC_GT      :
+		                                       CC_OTHER;
+}
+
+/* expand the classes from the bytes 0 .. 255 */
+template<unsigned int... C> struct CharClasses {
+	static constexpr unsigned char classes[sizeof...(C)] = {
+		char_class(C)...
+	};
+};
+template<unsigned int... C>
+constexpr unsigned char CharClasses<C...>::classes[sizeof...(C)];
+
+template<unsigned int N, unsigned int... C> struct MakeCharClasses :
+	MakeCharClasses<N - 1, N - 1, C...> {};
+template<unsigned int... C> struct MakeCharClasses<0, C...> :
+	CharClasses<C...> {};
+
+static constexpr const unsigned char *char_classes =
+	MakeCharClasses<256>::classes;
+
+/*
+ * The states of a tag after its first name character.  TS_QUOTED,
+ * TS_DONE and TS_ERROR have no row in tag_states[]: a quoted value is
+ * skipped in one go, after which the tag continues in TS_SPACE.
+ */
+enum TagState {
+	TS_TAG_NAME,     /* the name of a start tag */
+	TS_SPACE,        /* before an attribute */
+	TS_ATTR_NAME,
+	TS_ATTR_SPACE,   /* after an attribute name */
+	TS_GARBAGE,      /* junk after an attribute name, like att:"bla" */
+	TS_VALUE_SPACE,  /* after the '=' */
+	TS_VALUE,        /* an unquoted value */
+	TS_SLASH,        /* the '/' of XHTML tags like <hr /> */
+	TS_END_NAME,     /* the name of an end tag */
+	TS_END_SPACE,    /* after it, end tags have no attributes */
+	TS_QUOTED,
+	TS_DONE,
+	TS_ERROR
+};
+
+#define T_ TS_TAG_NAME
+#define S_ TS_SPACE
+#define A_ TS_ATTR_NAME
+#define AS TS_ATTR_SPACE
+#define G_ TS_GARBAGE
+#define VS TS_VALUE_SPACE
+#define V_ TS_VALUE
+#define SL TS_SLASH
+#define E_ TS_END_NAME
+#define ES TS_END_SPACE
+#define Q_ TS_QUOTED
+#define D_ TS_DONE
+#define X_ TS_ERROR
+static constexpr unsigned char tag_states[TS_QUOTED][CC_COUNT] = {
+	/*                other space ctrl start name  =  quote  /   >  EOF */
+	/* TS_TAG_NAME */    { X_, S_, X_, T_, T_, X_, X_, SL, D_, X_ },
+	/* TS_SPACE */       { X_, S_, X_, A_, X_, X_, X_, SL, D_, X_ },
+	/* TS_ATTR_NAME */   { G_, AS, G_, A_, A_, VS, G_, G_, D_, X_ },
+	/* TS_ATTR_SPACE */  { G_, AS, G_, G_, G_, VS, G_, G_, D_, X_ },
+	/* TS_GARBAGE */     { G_, S_, G_, G_, G_, G_, G_, G_, D_, X_ },
+	/* TS_VALUE_SPACE */ { V_, VS, X_, V_, V_, V_, Q_, V_, D_, X_ },
+	/* TS_VALUE */       { V_, S_, X_, V_, V_, V_, V_, V_, D_, X_ },
+	/* TS_SLASH */       { X_, X_, X_, X_, X_, X_, X_, X_, D_, X_ },
+	/* TS_END_NAME */    { X_, ES, X_, E_, E_, X_, X_, SL, D_, X_ },
+	/* TS_END_SPACE */   { X_, ES, X_, X_, X_, X_, X_, SL, D_, X_ },
+};
+#undef T_
+#undef S_
+#undef A_
+#undef AS
+#undef G_
+#undef VS
+#undef V_
+#undef SL
+#undef E_
+#undef ES
+#undef Q_
+#undef D_
+#undef X_
+
+/*
+ * Get the next character into c, multibyte characters are returned as
+ * their lead byte, and cp is left pointing to where c starts.
+ */
+#define GETC(c) \
+	do { \
+		cp = p; \
+		if (p == charsend) { \
+			if (!charseof) \
+				return NEED_MORE; \
+			c = EOF; \
+		} else { \
+			c = *p++; \
+			if (c >= 0x80) \
+				while (p < charsend && (*p & 0xC0) == 0x80) \
+					p++; \
+		} \
+	} while (0)
+
+/*
+ * Scan the markup p points to, which starts with a '<'.  Returns the
+ * token, or one of the codes above, with p moved past what was
+ * consumed.  Called again for the same markup after NEED_MORE, a tag
+ * carries on where scan_tag() left off, anything else starts over.
+ */
+int
+HTMLControl::scan_markup(const unsigned char *&p,
+		html2text::HTMLParser::semantic_type *value_return,
+		int *tag_type_return)
+{
+	const unsigned char *cp;
+	const unsigned char *q;
 	int c;
-	int state = 0;
 
-	for (;;) {
-		c = get_char();
-		if (c == EOF)
-			return false;
-		if (toupper(c) == terminal[state]) {
-			state++;
-			if (terminal[state] == '\0') {
-				// s.erase(s.length() - state);
-				// caused core dump on empty STYLE and
-				// SCRIPT elements - Johannes Geiger
-				s.erase(s.length() - state + 1);
-				return true;
+	if (tag_state >= 0)
+		return scan_tag(p, value_return, tag_type_return);
+
+	GETC(c);  /* the '<' */
+
+	/*
+	 * Examine the first character of the tag.
+	 */
+	GETC(c);
+	if (c == '!') {
+		GETC(c);
+		if (c == '-') {
+			GETC(c);
+			if (c != '-')
+				return HTMLParser_token::SCAN_ERROR;
+			return COMMENT;
+		}
+
+		/* scan <![if .... ]> <![endif]> kind of crap */
+		if (c == '[')
+			return MARKED_SECTION;
+
+		/*
+		 * Scan "<!DOCTYPE ...>" tag.
+		 */
+		if (!isalpha(c))
+			return HTMLParser_token::SCAN_ERROR;
+		q = cp;
+		for (;;) {
+			GETC(c);
+			if (!isalnum(c) && c != '-')
+				break;
+		}
+		if (_cmp_nocase((const char *)q, cp - q, "DOCTYPE", 7) != 0)
+			return HTMLParser_token::SCAN_ERROR;
+		if (c != '>') {
+			// Let newline not close the DOCTYPE tag - Arno
+			q = (const unsigned char *)memchr(p, '>', charsend - p);
+			if (q == NULL) {
+				if (!charseof)
+					return NEED_MORE;
+				p = charsend;
+				return HTMLParser_token::SCAN_ERROR;
 			}
-		} else {
-			state = 0;
+			p = q + 1;
 		}
-		s += c;
+		return HTMLParser_token::DOCTYPE;
 	}
+
+	if (c == '/' || (c != EOF && char_classes[c] == CC_NAME_START)) {
+		tag_is_end = false;
+		if (c == '/') {
+			tag_is_end = true;
+			GETC(c);
+		}
+		if (c == EOF || char_classes[c] != CC_NAME_START)
+			return HTMLParser_token::SCAN_ERROR;
+		tag_state = tag_is_end ? TS_END_NAME : TS_TAG_NAME;
+		tag_pos = p - chars;
+		tag_index = -1;
+		tag_keep = false;
+		attr_marks.clear();
+		return scan_tag(p, value_return, tag_type_return);
+	}
+
+	return LITERAL;
 }
 
+#undef GETC
+
+/*
+ * Scan the rest of the tag at chars, after the first character of its
+ * name, from where tag_state and tag_pos say.  These, and the other
+ * tag_ members and attr_marks, are offsets from chars, which stay the
+ * same when the window moves, so a tag that continues past the window
+ * is not scanned again from its start after NEED_MORE.
+ */
 int
-HTMLControl::get_char()
+HTMLControl::scan_tag(const unsigned char *&p,
+		html2text::HTMLParser::semantic_type *value_return,
+		int *tag_type_return)
 {
-	/* our input is always converted to UTF-8, so load bytes as required */
-	unsigned int c = 0;
+	const unsigned char *tag_name = chars + (tag_is_end ? 2 : 1);
+	const unsigned char *cp;
+	const unsigned char *q;
+	const TextToIntP *tag;
+	int state = tag_state;
+	int next;
+	int c;
 
-	if (number_of_ungotten_chars > 0) {
-		c = ungotten_chars[--number_of_ungotten_chars];
-	} else {
-		c = is.get();
-		while (c == '\r')
-			c = is.get();
+	p = chars + tag_pos;
+	tag_state = -1;
 
-		if (c == (unsigned int)EOF) {
-			;
-		} else if (c == '\n') {
-			current_line++;
-			current_column = 0;
+	/*
+	 * Run the tag through the DFA, noting where the names and
+	 * values of its attributes are, they are copied once the
+	 * tag turns out fine.  The states only change a few times
+	 * per attribute, so that is where the work is done.  The
+	 * tag is looked up as soon as its name is complete, such
+	 * that the attributes of a tag that is swallowed anyway are
+	 * not noted.
+	 */
+	do {
+		if (state == TS_QUOTED) {
+			// Same as opening quote!
+			q = (const unsigned char *)memchr(p, chars[tag_quote],
+					charsend - p);
+			if (q == NULL) {
+				if (!charseof) {
+					tag_state = state;
+					tag_pos = charsend - chars;
+					return NEED_MORE;
+				}
+				p = charsend;
+				return HTMLParser_token::SCAN_ERROR;
+			}
+			// Accept multiple-line elements - Arno
+
+			/*
+			 * Do *not* interpret "&auml;" and consorts
+			 * here! This would ruin tag attributes like
+			 * "HREF=hhh?a=1&b=2".
+			 */
+			if (tag_keep) {
+				attr_marks[attr_marks.size() - 2] = tag_quote + 1;
+				attr_marks.back() = q - chars;
+			}
+			p = q + 1;
+			state = TS_SPACE;
+			continue;
+		}
+
+		cp = p;
+		if (p == charsend) {
+			if (!charseof) {
+				tag_state = state;
+				tag_pos = p - chars;
+				return NEED_MORE;
+			}
+			c = EOF;
+			next = tag_states[state][CC_EOF];
 		} else {
-			current_column++;
-			if ((c >> 7) & 1) {
-				unsigned char nextpoint = 1;
+			c = *p++;
+			if (c >= 0x80)
+				while (p < charsend && (*p & 0xC0) == 0x80)
+					p++;
+			next = tag_states[state][char_classes[c]];
+		}
+		if (next == state)
+			continue;
+
+		switch (state) {
+		case TS_TAG_NAME:
+		case TS_END_NAME:
+			tag_len = cp - tag_name;
+			tag_index = lookup_name<TagTable>(tag_name, tag_len);
+			tag_keep = tag_index >= 0 || debug_scanner || handler != NULL;
+			break;
+		case TS_ATTR_NAME:
+			/* without a value, it is empty */
+			if (!tag_keep)
+				break;
+			attr_marks.push_back(tag_attr_name);
+			attr_marks.push_back(cp - chars);
+			attr_marks.push_back(cp - chars);
+			attr_marks.push_back(cp - chars);
+			break;
+		case TS_VALUE:
+			if (tag_keep)
+				attr_marks.back() = cp - chars;
+			break;
+		}
+
+		switch (next) {
+		case TS_ATTR_NAME:
+			tag_attr_name = cp - chars;
+			break;
+		case TS_VALUE:
+			if (tag_keep)
+				attr_marks[attr_marks.size() - 2] = cp - chars;
+			break;
+		case TS_QUOTED:
+			tag_quote = cp - chars;
+			break;
+		case TS_ERROR:
+			return HTMLParser_token::SCAN_ERROR;
+		}
+		state = next;
+	} while (state != TS_DONE);
+
+	tag = tag_index < 0 ? NULL : &tag_names[tag_index];
+
+	if (debug_scanner) {
+		std::cerr << "Scanned tag \"<" <<
+			(tag_is_end ? "/" : "");
+		std::cerr.write((const char *)tag_name, tag_len);
+		for (size_t i = 0; i < attr_marks.size(); i += 4) {
+			istr value;
+
+			value.append(chars + attr_marks[i + 2],
+					attr_marks[i + 3] - attr_marks[i + 2]);
+			std::cerr << " ";
+			std::cerr.write((const char *)chars + attr_marks[i],
+					attr_marks[i + 1] - attr_marks[i]);
+			std::cerr << "=\"" << value.c_str() << "\"";
+		}
+		std::cerr << ">\"" << std::endl;
+	}
+
+	if (handler != NULL)
+		report_tag(tag_name, tag_len, tag_is_end);
+
+	if (tag == NULL) { /* EXTENSION: Swallow unknown tags. */
+		if (debug_scanner) {
+			std::cerr << "Tag unknown -- swallowed." << std::endl;
+		}
+		return SWALLOWED;
+	}
 
-				/* we assume iconv produced valid UTF-8 here */
-				while ((c >> (7 - nextpoint)) & 1)
-					c |= ((is.get() & 0xFF) << (8 * nextpoint++));
+	/*
+	 * Return the BISON token code for the tag.
+	 */
+	if (tag_is_end) {
+		if (!tag->end_tag_code) {
+			if (debug_scanner) {
+				std::cerr << "Non-container end tag scanned." <<
+					std::endl;
 			}
+			return SWALLOWED;
 		}
+		*tag_type_return = tag->block_tag ? BLOCK_END_TAG : END_TAG;
+		return tag->end_tag_code;
+	} else {
+		*tag_type_return = (
+			!tag->end_tag_code ? NON_CONTAINER_TAG :
+			tag->block_tag     ? BLOCK_START_TAG   : START_TAG
+			);
+		if (handler != NULL || mode == HTMLDriver::SYNTAX_CHECK ||
+				(discard && (
+				tag->start_tag_code == HTMLParser_token::SCRIPT ||
+				tag->start_tag_code == HTMLParser_token::STYLE ||
+				tag->start_tag_code == HTMLParser_token::META)))
+			value_return->tag_attributes = NULL;
+		else
+			value_return->tag_attributes = make_attributes();
+		return tag->start_tag_code;
+	}
+}
+
+/*
+ * Count the len bytes of markup scanned for token if it is discarded,
+ * and where the content of SCRIPT and STYLE is to be counted.
+ */
+void
+HTMLControl::count_discarded(int token, size_t len)
+{
+	switch (token) {
+	case HTMLParser_token::SCRIPT:
+		discard_count = &discarded.script;
+		break;
+	case HTMLParser_token::STYLE:
+		discard_count = &discarded.style;
+		break;
+	case HTMLParser_token::META:
+		discarded.meta += len;
+		return;
+	case COMMENT:
+		discarded.comment += len;
+		return;
+	default:
+		return;
+	}
+	*discard_count += len;
+}
+
+/*
+ * Copy the attributes attr_marks notes with a name get_attribute() knows
+ * into a new TagAttributes, returns NULL when there are none.
+ */
+TagAttributes *
+HTMLControl::make_attributes()
+{
+	TagAttributes *ret = NULL;
+
+	for (size_t i = 0; i < attr_marks.size(); i += 4) {
+		const unsigned char *value = chars + attr_marks[i + 2];
+		int id = lookup_name<AttrTable>(chars + attr_marks[i],
+				attr_marks[i + 1] - attr_marks[i]);
+
+		if (id < 0)
+			continue;
+		if (ret == NULL)
+			ret = new TagAttributes;
+		if (is.span_retained(value))
+			ret->add_view((AttributeName)id, value,
+					attr_marks[i + 3] - attr_marks[i + 2]);
+		else
+			ret->add((AttributeName)id, value,
+					attr_marks[i + 3] - attr_marks[i + 2]);
 	}
+	return ret;
+}
 
-#if 0
-	if ((c >> 7) & 1) {
-		unsigned int d = c;
-		unsigned char point = 1;
-		fprintf(stderr, "utf-8 start %02x\n", c & 0xFF);
-		while ((c >> (7 - point++)) & 1) {
-			d >>= 8;
-			fprintf(stderr, "utf-8 join  %02x\n", d & 0xFF);
+/*
+ * Report the tag just scanned, with all attributes attr_marks notes,
+ * to the handler.
+ */
+void
+HTMLControl::report_tag(const unsigned char *name, size_t len,
+		bool is_end_tag)
+{
+	if (is_end_tag) {
+		handler->end_tag((const char *)name, len);
+		return;
+	}
+
+	handler_attrs.clear();
+	for (size_t i = 0; i < attr_marks.size(); i += 4) {
+		SaxAttribute a = {
+			(const char *)chars + attr_marks[i],
+			attr_marks[i + 1] - attr_marks[i],
+			(const char *)chars + attr_marks[i + 2],
+			attr_marks[i + 3] - attr_marks[i + 2]
 		};
+		handler_attrs.push_back(a);
 	}
-#endif
+	handler->start_tag((const char *)name, len,
+			handler_attrs.data(), handler_attrs.size());
+}
+
+int
+HTMLControl::parse_events(SaxHandler *handler_)
+{
+	html2text::HTMLParser::semantic_type value;
+	int tag_type;
+
+	handler = handler_;
+	for (;;) {
+		int token;
+
+		if (handler->stop)
+			return EOF;
+		if (cdata_terminal != NULL) {
+			bool ok = read_cdata(cdata_terminal, &handler_buf);
+
+			if (!ok && starving)
+				return NEED_INPUT;
+			if (!handler_buf.empty())
+				handler->text(handler_buf.data(), handler_buf.length());
+			if (ok)
+				handler->end_tag(cdata_terminal + 2,
+						strlen(cdata_terminal) - 3);
+			cdata_terminal = NULL;
+			continue;
+		}
+
+		/* the scanner reported all there is to the tokens it returns
+		 * already, except that SCRIPT and STYLE hold no markup */
+		token = yylex2(&value, &tag_type);
+		if (token == EOF || token == NEED_INPUT)
+			return token;
+		if (token == HTMLParser_token::SCRIPT)
+			cdata_terminal = "</SCRIPT>";
+		else if (token == HTMLParser_token::STYLE)
+			cdata_terminal = "</STYLE>";
+		handler_buf.clear();
+	}
+}
+
+/*
+ * This is a comment... skip it!  The "<!--" is consumed already,
+ * returns false when the input ends before the comment does.
+ *
+ *   <!-- Single-line comment -->
+ *
+ *   <!-- Multi-
+ *        line
+ *        comment //-->
+ *
+ * EXTENSION: Allow "-->" as the terminator of a
+ *            multi-line comment.
+ */
+bool
+HTMLControl::skip_comment()
+{
+	for (;;) {
+		const unsigned char *p = scan_find(chars, charsend, "-->", 3, false);
+		bool found = p != NULL;
+
+		if (!found) {
+			/* the terminator may continue in the next span */
+			p = charsend;
+			if (!charseof)
+				p = charsend - chars >= 3 ? p - 2 : chars;
+		}
+		if (handler != NULL)
+			handler_buf.append((const char *)chars, p - chars);
+		if (discard)
+			discarded.comment += p - chars + (found ? 3 : 0);
+		if (found) {
+			advance(p + 3);
+			return true;
+		}
+		advance(p);
+		if (!fill_chars(chars) && (chars == charsend || starving))
+			return false;
+	}
+}
+
+/*
+ * Skip the rest of <![if .... ]>, returns false if it is not closed
+ * properly.  Whether the ']' was seen is kept in marked_closed.
+ */
+bool
+HTMLControl::skip_marked_section()
+{
+	for (;;) {
+		const unsigned char *p = chars;
+
+		if (!marked_closed) {
+			p = (const unsigned char *)memchr(p, ']', charsend - p);
+			if (p == NULL) {
+				p = charsend;
+			} else {
+				marked_closed = true;
+				p++;
+			}
+		}
+		if (marked_closed) {
+			while (p < charsend && isspace(*p))
+				p++;
+			if (p < charsend) {
+				bool ok = *p == '>';
 
-	return c;
+				/* whatever we find here is consumed */
+				for (p++; p < charsend && (*p & 0xC0) == 0x80; p++)
+					;
+				advance(p);
+				return ok;
+			}
+		}
+		advance(p);
+		if (!fill_chars(chars))
+			return false;
+	}
 }
 
-/* ------------------------------------------------------------------------- */
+/*
+ * Append the input up to terminal to value_return, and consume it
+ * along with terminal, returns false when the input ends first.  When
+ * value_return is NULL, the input is only counted as discarded.
+ */
+bool
+HTMLControl::read_cdata(const char *terminal, string *value_return)
+{
+	size_t len = strlen(terminal);
+
+	for (;;) {
+		const unsigned char *p = scan_find(chars, charsend,
+				terminal, len, true);
+		bool found = p != NULL;
+
+		if (!found) {
+			/* the terminator may continue in the next span */
+			p = charsend;
+			if (!charseof)
+				p = (size_t)(charsend - chars) >= len ?
+					p - (len - 1) : chars;
+		}
+		if (value_return != NULL)
+			value_return->append((const char *)chars, p - chars);
+		else if (discard_count != NULL)
+			*discard_count += p - chars + (found ? len : 0);
+		if (found) {
+			advance(p + len);
+			return true;
+		}
+		advance(p);
+		if (!fill_chars(chars) && (chars == charsend || starving))
+			return false;
+	}
+}
 
+/*
+ * Consume the input up to "to", keeping track of the line we're on,
+ * the column is only counted when needed.
+ */
 void
-HTMLControl::unget_char(int c)
+HTMLControl::advance(const unsigned char *to)
 {
-	if (number_of_ungotten_chars == nelems(ungotten_chars)) {
-		//error("Too many chars ungotten");
-		return;
+	const unsigned char *p = chars;
+
+	while ((p = (const unsigned char *)memchr(p, '\n', to - p)) != NULL) {
+		current_line++;
+		current_column = 0;
+		linestart = ++p;
 	}
-	ungotten_chars[number_of_ungotten_chars++] = c;
+	chars = to;
+}
+
+/*
+ * Extend the window with the next span of input, keeping what is left
+ * of it from "keep" on, returns false on EOF.
+ */
+bool
+HTMLControl::fill_chars(const unsigned char *keep)
+{
+	const unsigned char *span;
+	size_t keeplen = charsend - keep;
+	size_t len;
+	size_t i;
+
+	if (charseof)
+		return false;
+	starving = false;
+
+	/* getting the next span invalidates the current one, and with it
+	 * linestart */
+	current_column += count_columns(linestart, chars);
+	if (keeplen > 0 && keep != carry.data()) {
+		if (carry.size() < keeplen)
+			carry.resize(keeplen);
+		memmove(carry.data(), keep, keeplen);
+	}
+	is.consume(spanlen);
+	len = spanlen = is.span(&span);
+	if (len == 0) {
+		/* with pushed input this may only be the end for now */
+		starving = is.starved();
+		charseof = !starving;
+		linestart = chars = carry.data();
+		charsend = chars + keeplen;
+		return false;
+	}
+
+	/* our input is always converted to UTF-8, and spans never split a
+	 * character, only '\r' needs to go */
+	if (keeplen == 0 && memchr(span, '\r', len) == NULL) {
+		linestart = chars = span;
+		charsend = span + len;
+		return true;
+	}
+
+	if (carry.size() < keeplen + len)
+		carry.resize(keeplen + len);
+	for (i = keeplen; len-- > 0; span++) {
+		if (*span != '\r')
+			carry[i++] = *span;
+	}
+	linestart = chars = carry.data();
+	charsend = chars + i;
+
+	return true;
 }
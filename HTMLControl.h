@@ -23,6 +23,7 @@
 #include <istream>
 
 #include "HTMLParser.tab.hh"
+#include "sax.h"
 
 using std::istream;
 
@@ -40,14 +41,79 @@ class HTMLControl {
 			next_token(EOF),
 			debug_scanner(debug_scanner_),
 			is(is_),
-			number_of_ungotten_chars(0)
+			chars(NULL),
+			charsend(NULL),
+			charseof(false),
+			spanlen(0),
+			starving(false),
+			tag_state(-1),
+			linestart(NULL),
+			skipping(0),
+			marked_closed(false),
+			partial(NULL),
+			held_token(EOF),
+			handler(NULL),
+			cdata_terminal(NULL),
+			discard(false),
+			discard_count(NULL)
 	{
+		memset(&discarded, 0, sizeof(discarded));
 	}
 
+		/*
+		 * With input pushed to is (iconvstream::open_push()), the
+		 * scanner stops where the input runs out, be it halfway a
+		 * tag, comment, entity or character.  htmlparser_yylex()
+		 * then returns NEED_INPUT, and read_cdata() false with
+		 * starved() set, call them again once more is pushed.  The
+		 * parser cannot be driven like this, it would take NEED_INPUT
+		 * for a token, push input is for htmlparser_yylex() and
+		 * parse_events() callers only.
+		 */
+		enum { NEED_INPUT = -2 };
+
 		void htmlparser_yyerror(const char *p);
 		int htmlparser_yylex(
 				html2text::HTMLParser::semantic_type *value_return);
 		bool read_cdata(const char *terminal, string *value_return);
+		bool starved() const
+		{
+			return starving;
+		}
+
+		/*
+		 * Instead of tokens for the parser, report what is in the
+		 * input to handler as it is scanned, see sax.h.  Returns EOF
+		 * at the end or when the handler stops, or NEED_INPUT as
+		 * above.
+		 */
+		int parse_events(SaxHandler *handler_);
+
+		/*
+		 * Nothing of SCRIPT, STYLE, META or comments is rendered, with
+		 * discard set no attributes are kept for these tags, and
+		 * read_cdata() skips the content of the first two when given
+		 * no string to append it to.  The bytes of input they took are
+		 * counted in discarded.
+		 */
+		struct discard_stats {
+			size_t script;
+			size_t style;
+			size_t meta;
+			size_t comment;
+		};
+		void set_discard(bool enable)
+		{
+			discard = enable;
+		}
+		bool discarding() const
+		{
+			return discard;
+		}
+		const struct discard_stats &get_discard_stats() const
+		{
+			return discarded;
+		}
 		int mode;
 		int current_line;
 		int current_column;
@@ -65,14 +131,77 @@ class HTMLControl {
 		html2text::HTMLParser::semantic_type next_token_value;
 		int next_token_tag_type;
 
-		int get_char();
-		void unget_char(int);
+		bool look_ahead();
+		int scan_markup(const unsigned char *&p,
+				html2text::HTMLParser::semantic_type *value_return,
+				int *tag_type_return);
+		int scan_tag(const unsigned char *&p,
+				html2text::HTMLParser::semantic_type *value_return,
+				int *tag_type_return);
+		int scan_pcdata(html2text::HTMLParser::semantic_type *value_return);
+		TagAttributes *make_attributes();
+		void count_discarded(int token, size_t len);
+		void report_tag(const unsigned char *name, size_t len,
+				bool is_end_tag);
+		bool skip_comment();
+		bool skip_marked_section();
+		void advance(const unsigned char *to);
+		bool fill_chars(const unsigned char *keep);
 
 		bool debug_scanner;
 
 		iconvstream &is;
-		int ungotten_chars[5];
-		int number_of_ungotten_chars;
+		/* the window of input the scanner works on, chars is where the
+		 * next token starts, this is either the span from is itself,
+		 * or a copy in carry, when a token continues into the next
+		 * span, or when '\r' needs to be removed from it */
+		const unsigned char *chars;
+		const unsigned char *charsend;
+		bool charseof;
+		size_t spanlen;
+		/* is ran out of pushed input, which is not EOF */
+		bool starving;
+		vector<unsigned char> carry;
+		/* start and end of the name and value of each attribute of
+		 * the tag being scanned, as offsets from chars, the '<' */
+		vector<size_t> attr_marks;
+		/* the tag being scanned: the state scan_tag() carries on in
+		 * after the window is extended, or -1, and where it was, the
+		 * offsets are from chars as well */
+		int tag_state;
+		size_t tag_pos;
+		size_t tag_len;
+		size_t tag_attr_name;
+		size_t tag_quote;
+		int tag_index;
+		bool tag_is_end;
+		bool tag_keep;
+		/* current_column is the column at linestart, the rest is
+		 * counted when needed */
+		const unsigned char *linestart;
+		/* what the scanner was in the middle of when pushed input ran
+		 * out: a comment or marked section being skipped, text being
+		 * collected, or a token waiting for the one after it */
+		int skipping;
+		bool marked_closed;
+		PCData *partial;
+		int held_token;
+		html2text::HTMLParser::semantic_type held_token_value;
+		int held_token_tag_type;
+
+		/* for parse_events(), text is collected in handler_text, and
+		 * comments and the content of SCRIPT and STYLE, ending at
+		 * cdata_terminal, in handler_buf, both are reused */
+		SaxHandler *handler;
+		PCData handler_text;
+		string handler_buf;
+		const char *cdata_terminal;
+		vector<SaxAttribute> handler_attrs;
+
+		bool discard;
+		struct discard_stats discarded;
+		/* the counter of the SCRIPT or STYLE last scanned */
+		size_t *discard_count;
 };
 
 #endif /* } */
@@ -22,7 +22,8 @@ HTMLDriver::HTMLDriver(HTMLControl& c,
 		int& width_,
 		int& mode_,
 		bool& debug_parser) :
-	enable_links(enable_links_),
+	/* a syntax check prints no references */
+	enable_links(enable_links_ && mode_ != SYNTAX_CHECK),
 	control(c),
 	trace_parsing(debug_parser),
 	width(width_),
@@ -80,6 +81,16 @@ bool HTMLDriver::read_cdata(const char *terminal, string *ret)
 	return control.read_cdata(terminal, ret);
 }
 
+bool HTMLDriver::discarding()
+{
+	return control.discarding();
+}
+
+bool HTMLDriver::checking()
+{
+	return mode == SYNTAX_CHECK;
+}
+
 void HTMLDriver::yyerror(const char *msg)
 {
 	return control.htmlparser_yyerror(msg);
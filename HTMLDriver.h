@@ -32,12 +32,14 @@ class HTMLDriver {
 		void yyerror(const char *msg);
 		void process(const Document&);
 		bool read_cdata(const char *terminal, string *);
+		bool discarding();
+		bool checking();
 		int list_nesting = 0;
 		bool enable_links;
 		OrderedList *links = nullptr;
 
 		enum {
-			PRINT_AS_ASCII, SYNTAX_CHECK
+			PRINT_AS_ASCII, SYNTAX_CHECK, HEAD_ONLY
 		};
 
 	private:
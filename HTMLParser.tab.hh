@@ -45,7 +45,7 @@
 #ifndef YY_YY_HTMLPARSER_TAB_HH_INCLUDED
 # define YY_YY_HTMLPARSER_TAB_HH_INCLUDED
 // "%code requires" blocks.
-#line 43 "HTMLParser.yy"
+#line 26 "HTMLParser.yy"
 
 #include <string>
 #define HTMLParser_token html2text::HTMLParser::token
@@ -187,7 +187,7 @@ class HTMLDriver;
 # define YYDEBUG 1
 #endif
 
-#line 40 "HTMLParser.yy"
+#line 23 "HTMLParser.yy"
 namespace html2text {
 #line 193 "HTMLParser.tab.hh"
 
@@ -207,14 +207,13 @@ namespace html2text {
     /// Symbol semantic values.
     union value_type
     {
-#line 67 "HTMLParser.yy"
+#line 62 "HTMLParser.yy"
 
   Document                           *document;
   Element                            *element;
   list<auto_ptr<Element>>            *element_list;
   PCData                             *pcdata;
-  istr                               *strinG;
-  list<TagAttribute>                 *tag_attributes;
+  TagAttributes                      *tag_attributes;
   int                                inT;
   list<auto_ptr<TableRow>>           *table_rows;
   list<auto_ptr<TableCell>>          *table_cells;
@@ -230,9 +229,9 @@ namespace html2text {
   TermDefinition                     *term_definition;
   Preformatted                       *preformatted;
   Address                            *address;
-  list<auto_ptr<list<TagAttribute>>> *tag_attributes_list;
+  list<auto_ptr<TagAttributes>>      *tag_attributes_list;
 
-#line 236 "HTMLParser.tab.hh"
+#line 235 "HTMLParser.tab.hh"
 
     };
 #endif
@@ -1133,9 +1132,9 @@ namespace html2text {
   };
 
 
-#line 40 "HTMLParser.yy"
+#line 23 "HTMLParser.yy"
 } // html2text
-#line 1139 "HTMLParser.tab.hh"
+#line 1138 "HTMLParser.tab.hh"
 
 
 
@@ -43,6 +43,20 @@ class HTMLDriver;
 #define yylex drv.lex
 #undef yyerror
 #define yyerror drv.yyerror
+
+/*
+ * Append e to the list l, unless this is a syntax check, which only
+ * looks at whether the input parses: then e is released right away,
+ * such that the document never grows however large the input is.
+ */
+template<class T, class E> static void
+append(HTMLDriver &drv, list<auto_ptr<T>> &l, E *e)
+{
+  auto_ptr<T> p(e);
+
+  if (!drv.checking())
+    l.push_back(p);
+}
 }
 
 %union {
@@ -50,8 +64,7 @@ class HTMLDriver;
   Element                            *element;
   list<auto_ptr<Element>>            *element_list;
   PCData                             *pcdata;
-  istr                               *strinG;
-  list<TagAttribute>                 *tag_attributes;
+  TagAttributes                      *tag_attributes;
   int                                inT;
   list<auto_ptr<TableRow>>           *table_rows;
   list<auto_ptr<TableCell>>          *table_cells;
@@ -67,7 +80,7 @@ class HTMLDriver;
   TermDefinition                     *term_definition;
   Preformatted                       *preformatted;
   Address                            *address;
-  list<auto_ptr<list<TagAttribute>>> *tag_attributes_list;
+  list<auto_ptr<TagAttributes>>      *tag_attributes_list;
 }
 
 %type  <document>                 document_
@@ -112,7 +125,7 @@ class HTMLDriver;
 %type  <tag_attributes> opt_P
 
 %token                  DOCTYPE
-%token <strinG>         PCDATA
+%token <pcdata>         PCDATA
 %token                  SCAN_ERROR
 
 
@@ -316,28 +329,45 @@ document_:
     ($$ = $1)->head.base_attributes.reset($2);
   }
   | document_ META {
-    auto_ptr<Meta> s(new Meta);
-    s->attributes.reset($2);
-    ($$ = $1)->head.metas.push_back(s);
+    $$ = $1;
+    if (!drv.discarding()) {
+      auto_ptr<Meta> s(new Meta);
+      s->attributes.reset($2);
+      $$->head.metas.push_back(s);
+    }
   }
   | document_ LINK {
     ($$ = $1)->head.link_attributes.reset($2);
   }
   | document_ SCRIPT {
-    auto_ptr<Script> s(new Script);
-    s->attributes.reset($2);
-    if (!drv.read_cdata("</SCRIPT>", &s->text)) {
-      yyerror("CDATA terminal not found");
+    $$ = $1;
+    if (drv.discarding()) {
+      if (!drv.read_cdata("</SCRIPT>", NULL)) {
+        yyerror("CDATA terminal not found");
+      }
+    } else {
+      auto_ptr<Script> s(new Script);
+      s->attributes.reset($2);
+      if (!drv.read_cdata("</SCRIPT>", &s->text)) {
+        yyerror("CDATA terminal not found");
+      }
+      $$->head.scripts.push_back(s);
     }
-    ($$ = $1)->head.scripts.push_back(s);
   }
   | document_ STYLE {
-    auto_ptr<Style> s(new Style);
-    s->attributes.reset($2);
-    if (!drv.read_cdata("</STYLE>", &s->text)) {
-      yyerror("CDATA terminal not found");
+    $$ = $1;
+    if (drv.discarding()) {
+      if (!drv.read_cdata("</STYLE>", NULL)) {
+        yyerror("CDATA terminal not found");
+      }
+    } else {
+      auto_ptr<Style> s(new Style);
+      s->attributes.reset($2);
+      if (!drv.read_cdata("</STYLE>", &s->text)) {
+        yyerror("CDATA terminal not found");
+      }
+      $$->head.styles.push_back(s);
     }
-    ($$ = $1)->head.styles.push_back(s);
   }
   | document_ BODY {
     delete $2;
@@ -349,24 +379,22 @@ document_:
   | document_ texts {
     Paragraph *p = new Paragraph;
     p->texts.reset($2);
-    ($$ = $1)->body.content->push_back(auto_ptr<Element>(p));
+    append(drv, *($$ = $1)->body.content, p);
   }
   | document_ heading {
-    ($$ = $1)->body.content->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1)->body.content, $2);
   }
   | document_ block {
-    ($$ = $1)->body.content->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1)->body.content, $2);
   }
   | document_ address {
-    ($$ = $1)->body.content->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1)->body.content, $2);
   }
   ;
 
 pcdata:
   PCDATA {
-    $$ = new PCData;
-    $$->text = *$1;
-    delete $1;
+    $$ = $1;
   }
   ;
 
@@ -378,20 +406,32 @@ body_content:
     $$ = $1;
   }
   | body_content SCRIPT {
-    auto_ptr<Script> s(new Script);
-    s->attributes.reset($2);
-    if (!drv.read_cdata("</SCRIPT>", &s->text)) {
-      yyerror("CDATA terminal not found");
+    if (drv.discarding()) {
+      if (!drv.read_cdata("</SCRIPT>", NULL)) {
+        yyerror("CDATA terminal not found");
+      }
+    } else {
+      auto_ptr<Script> s(new Script);
+      s->attributes.reset($2);
+      if (!drv.read_cdata("</SCRIPT>", &s->text)) {
+        yyerror("CDATA terminal not found");
+      }
+//      ($$ = $1)->head.scripts.push_back(s);
     }
-//    ($$ = $1)->head.scripts.push_back(s);
   }
   | body_content STYLE {
-    auto_ptr<Style> s(new Style);
-    s->attributes.reset($2);
-    if (!drv.read_cdata("</STYLE>", &s->text)) {
-      yyerror("CDATA terminal not found");
+    if (drv.discarding()) {
+      if (!drv.read_cdata("</STYLE>", NULL)) {
+        yyerror("CDATA terminal not found");
+      }
+    } else {
+      auto_ptr<Style> s(new Style);
+      s->attributes.reset($2);
+      if (!drv.read_cdata("</STYLE>", &s->text)) {
+        yyerror("CDATA terminal not found");
+      }
+//      ($$ = $1)->head.styles.push_back(s);
     }
-//    ($$ = $1)->head.styles.push_back(s);
   }
   | body_content META {
     /* This seems to happen for instance by Mozilla Thunderbird in its
@@ -402,16 +442,16 @@ body_content:
   | body_content texts {
     Paragraph *p = new Paragraph;
     p->texts = auto_ptr<list<auto_ptr<Element> > >($2);
-    ($$ = $1)->push_back(auto_ptr<Element>(p));
+    append(drv, *($$ = $1), p);
   }
   | body_content heading {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   | body_content block {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   | body_content address {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   ;
 
@@ -451,7 +491,7 @@ paragraph_content:  /* EXTENSION: Allow blocks (except "<P>") in paragraphs. */
     delete $2;
   }
   | paragraph_content block_except_p {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   ;
 
@@ -543,7 +583,7 @@ list_content:
   }
   | list_content list_item {
     $$ = $1 ? $1 : new list<auto_ptr<ListItem> >;
-    $$->push_back(auto_ptr<ListItem>($2));
+    append(drv, *$$, $2);
   }
   ;
 
@@ -593,11 +633,11 @@ definition_list_content:
   }
   | definition_list_content term_name {
     $$ = $1 ? $1 : new list<auto_ptr<DefinitionListItem> >;
-    $$->push_back(auto_ptr<DefinitionListItem>($2));
+    append(drv, *$$, $2);
   }
   | definition_list_content term_definition {
     $$ = $1 ? $1 : new list<auto_ptr<DefinitionListItem> >;
-    $$->push_back(auto_ptr<DefinitionListItem>($2));
+    append(drv, *$$, $2);
   }
   ;
 
@@ -632,13 +672,13 @@ term_definition:
 flow:
   flow_ {
     $$ = new list<auto_ptr<Element> >;
-    $$->push_back(auto_ptr<Element>($1));
+    append(drv, *$$, $1);
   }
   | flow error {
     $$ = $1;
   }
   | flow flow_ {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   ;
 
@@ -681,7 +721,7 @@ table_rows:
     TableRow *tr = new TableRow;
     tr->attributes.reset($2);
     tr->cells.reset($3);
-    ($$ = $1)->push_back(auto_ptr<TableRow>(tr));
+    append(drv, *($$ = $1), tr);
   }
   ;
 
@@ -696,14 +736,14 @@ table_cells:
     TableCell *tc = new TableCell;
     tc->attributes.reset($2);
     tc->content.reset($3);
-    ($$ = $1)->push_back(auto_ptr<TableCell>(tc));
+    append(drv, *($$ = $1), tc);
   }
   | table_cells TH body_content opt_END_TH opt_END_TD {
                             /* EXTENSION: Allow "</TD>" in place of "</TH>". */
     TableHeadingCell *thc = new TableHeadingCell;
     thc->attributes.reset($2);
     thc->content.reset($3);
-    ($$ = $1)->push_back(auto_ptr<TableCell>(thc));
+    append(drv, *($$ = $1), thc);
   }
   | table_cells INPUT {    /* EXTENSION: Ignore <INPUT> between table cells. */
     delete $2;
@@ -722,10 +762,10 @@ address:
 texts:
   text {
     $$ = new list<auto_ptr<Element> >;
-    $$->push_back(auto_ptr<Element>($1));
+    append(drv, *$$, $1);
   }
   | texts text {
-    ($$ = $1)->push_back(auto_ptr<Element>($2));
+    append(drv, *($$ = $1), $2);
   }
   ;
 
@@ -778,7 +818,7 @@ special:
     a->refnum = 0;
     $$ = a;
 
-	istr href = get_attribute(a->attributes.get(), "HREF", "");
+	istr href = get_attribute(a->attributes.get(), ATTR_HREF, "");
 	if (drv.enable_links && !href.empty() && href[0] != '#') {
         ListNormalItem *lni = new ListNormalItem;
         PCData *d = new PCData;
@@ -791,10 +831,10 @@ special:
     }
   }
   | IMG {
-	auto_ptr<list<TagAttribute>> attr;
+	auto_ptr<TagAttributes> attr;
 	attr.reset($1);
-	istr src = get_attribute(attr.get(), "SRC", "");
-	istr alt = get_attribute(attr.get(), "ALT", "");
+	istr src = get_attribute(attr.get(), ATTR_SRC, "");
+	istr alt = get_attribute(attr.get(), ATTR_ALT, "");
 	/* when ALT is empty, and we have SRC, replace it with a link */
 	if (drv.enable_links && !src.empty() && alt.empty()) {
 		PCData *d = new PCData;
@@ -803,11 +843,7 @@ special:
         list<auto_ptr<Element>> *data = new list<auto_ptr<Element>>;
         data->push_back(auto_ptr<Element>(d));
 
-		TagAttribute attribute;
-		string href = "HREF";
-		attribute.first = href;
-		attribute.second = src;
-		attr->push_back(attribute);
+		attr->add(ATTR_HREF, src);
 
 		Anchor *a = new Anchor;
 		a->attributes = attr;
@@ -868,13 +904,13 @@ applet_content:
   }
   | applet_content text {
     $$ = $1 ? $1 : new list<auto_ptr<Element> >;
-    $$->push_back(auto_ptr<Element>($2));
+    append(drv, *$$, $2);
   }
   | applet_content PARAM {
     $$ = $1 ? $1 : new list<auto_ptr<Element> >;
     Param *p = new Param;
     p->attributes.reset($2);
-    $$->push_back(auto_ptr<Element>(p));
+    append(drv, *$$, p);
   }
   ;
 
@@ -886,8 +922,8 @@ map_content:
     $$ = $1;
   }
   | map_content AREA {
-    $$ = $1 ? $1 : new list<auto_ptr<list<TagAttribute> > >;
-    $$->push_back(auto_ptr<list<TagAttribute> >($2));
+    $$ = $1 ? $1 : new list<auto_ptr<TagAttributes> >;
+    append(drv, *$$, $2);
   }
   ;
 
@@ -914,10 +950,10 @@ form:
 select_content:
   option {
     $$ = new list<auto_ptr<Option> >;
-    $$->push_back(auto_ptr<Option>($1));
+    append(drv, *$$, $1);
   }
   | select_content option {
-    ($$ = $1)->push_back(auto_ptr<Option>($2));
+    append(drv, *($$ = $1), $2);
   }
   ;
 
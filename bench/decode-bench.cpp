@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+/*
+ * Compares the built-in single-byte decoders against iconv, on input
+ * that mimics western mail text: mostly ASCII with some accented
+ * letters and punctuation from the upper half.
+ *   usage: decode-bench [charset [megabytes]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <iconv.h>
+
+#include "../charsets.h"
+
+static const size_t CHUNKSZE = 64 * 1024;
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const char *name = argc > 1 ? argv[1] : "WINDOWS-1252";
+	size_t len = (argc > 2 ? atoi(argv[2]) : 64) * 1024 * 1024;
+	const struct charset *cs = charset_find(name);
+	unsigned char *in = new unsigned char[len];
+	unsigned char *out = new unsigned char[CHUNKSZE * 4];
+	size_t outtbl = 0;
+	size_t outicv = 0;
+	size_t replaced = 0;
+	size_t pos;
+	double start;
+	double ttbl;
+	double ticv;
+	iconv_t cd;
+
+	if (cs == NULL) {
+		fprintf(stderr, "no built-in decoder for %s\n", name);
+		return 1;
+	}
+	cd = iconv_open("UTF-8", name);
+	if (cd == iconv_t(-1)) {
+		fprintf(stderr, "iconv doesn't know %s\n", name);
+		return 1;
+	}
+
+	srand(1);
+	for (pos = 0; pos < len; pos++) {
+		int r = rand() % 100;
+		if (r < 3)
+			in[pos] = 0xC0 + rand() % 64;
+		else if (r < 4)
+			in[pos] = 0xA0 + rand() % 32;
+		else if (r < 18)
+			in[pos] = ' ';
+		else
+			in[pos] = 'a' + rand() % 26;
+	}
+
+	start = now();
+	for (pos = 0; pos < len; pos += CHUNKSZE)
+		outtbl += charset_decode(cs, in + pos,
+				len - pos < CHUNKSZE ? len - pos : CHUNKSZE, out, &replaced);
+	ttbl = now() - start;
+
+	start = now();
+	for (pos = 0; pos < len; pos += CHUNKSZE) {
+		char *inp = (char *)in + pos;
+		char *outp = (char *)out;
+		size_t inlen = len - pos < CHUNKSZE ? len - pos : CHUNKSZE;
+		size_t outlen = CHUNKSZE * 4;
+
+		while (iconv(cd, &inp, &inlen, &outp, &outlen) == (size_t)-1 &&
+				errno == EILSEQ)
+		{
+			*outp++ = '?';
+			inp++;
+			inlen--;
+			outlen--;
+		}
+		outicv += outp - (char *)out;
+	}
+	ticv = now() - start;
+	iconv_close(cd);
+
+	printf("%s, %zu MiB input, %zu/%zu bytes output\n",
+			name, len >> 20, outtbl, outicv);
+	printf("  table: %8.1f MB/s\n", len / ttbl / 1e6);
+	printf("  iconv: %8.1f MB/s\n", len / ticv / 1e6);
+
+	delete[] in;
+	delete[] out;
+
+	return outtbl == outicv ? 0 : 1;
+}
@@ -0,0 +1,1305 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "charsets.h"
+#include "utf8.h"
+
+#ifndef nelems
+#define nelems(array) (sizeof(array) / sizeof((array)[0]))
+#endif
+
+/*
+ * Code points for bytes 0x80 up to 0xFF, the lower half is ASCII for
+ * all of these.  NOCHAR marks bytes that are undefined in the charset,
+ * glibc's iconv rejects these.  The tables were generated from glibc's
+ * iconv, so we decode exactly the same.
+ */
+
+#define NOCHAR 0xFFFF
+
+static constexpr unsigned short iso8859_2[128] = {
+	0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,  /* 0x80 */
+	0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,  /* 0x88 */
+	0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,  /* 0x90 */
+	0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,  /* 0x98 */
+	0x00A0, 0x0104, 0x02D8, 0x0141, 0x00A4, 0x013D, 0x015A, 0x00A7,  /* 0xA0 */
+	0x00A8, 0x0160, 0x015E, 0x0164, 0x0179, 0x00AD, 0x017D, 0x017B,  /* 0xA8 */
+	0x00B0, 0x0105, 0x02DB, 0x0142, 0x00B4, 0x013E, 0x015B, 0x02C7,  /* 0xB0 */
+	0x00B8, 0x0161, 0x015F, 0x0165, 0x017A, 0x02DD, 0x017E, 0x017C,  /* 0xB8 */
+	0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,  /* 0xC0 */
+	0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,  /* 0xC8 */
+	0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,  /* 0xD0 */
+	0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,  /* 0xD8 */
+	0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,  /* 0xE0 */
+	0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,  /* 0xE8 */
+	0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,  /* 0xF0 */
+	0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,  /* 0xF8 */
+};
+
+static constexpr unsigned short iso8859_15[128] = {
+	0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,  /* 0x80 */
+	0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,  /* 0x88 */
+	0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,  /* 0x90 */
+	0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,  /* 0x98 */
+	0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x20AC, 0x00A5, 0x0160, 0x00A7,  /* 0xA0 */
+	0x0161, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,  /* 0xA8 */
+	0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x017D, 0x00B5, 0x00B6, 0x00B7,  /* 0xB0 */
+	0x017E, 0x00B9, 0x00BA, 0x00BB, 0x0152, 0x0153, 0x0178, 0x00BF,  /* 0xB8 */
+	0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,  /* 0xC0 */
+	0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,  /* 0xC8 */
+	0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,  /* 0xD0 */
+	0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,  /* 0xD8 */
+	0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,  /* 0xE0 */
+	0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,  /* 0xE8 */
+	0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,  /* 0xF0 */
+	0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,  /* 0xF8 */
+};
+
+static constexpr unsigned short windows_1250[128] = {
+	0x20AC, NOCHAR, 0x201A, NOCHAR, 0x201E, 0x2026, 0x2020, 0x2021,  /* 0x80 */
+	NOCHAR, 0x2030, 0x0160, 0x2039, 0x015A, 0x0164, 0x017D, 0x0179,  /* 0x88 */
+	NOCHAR, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,  /* 0x90 */
+	NOCHAR, 0x2122, 0x0161, 0x203A, 0x015B, 0x0165, 0x017E, 0x017A,  /* 0x98 */
+	0x00A0, 0x02C7, 0x02D8, 0x0141, 0x00A4, 0x0104, 0x00A6, 0x00A7,  /* 0xA0 */
+	0x00A8, 0x00A9, 0x015E, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x017B,  /* 0xA8 */
+	0x00B0, 0x00B1, 0x02DB, 0x0142, 0x00B4, 0x00B5, 0x00B6, 0x00B7,  /* 0xB0 */
+	0x00B8, 0x0105, 0x015F, 0x00BB, 0x013D, 0x02DD, 0x013E, 0x017C,  /* 0xB8 */
+	0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,  /* 0xC0 */
+	0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,  /* 0xC8 */
+	0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,  /* 0xD0 */
+	0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,  /* 0xD8 */
+	0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,  /* 0xE0 */
+	0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,  /* 0xE8 */
+	0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,  /* 0xF0 */
+	0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,  /* 0xF8 */
+};
+
+static constexpr unsigned short windows_1251[128] = {
+	0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021,  /* 0x80 */
+	0x20AC, 0x2030, 0x0409, 0x2039, 0x040A, 0x040C, 0x040B, 0x040F,  /* 0x88 */
+	0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,  /* 0x90 */
+	NOCHAR, 0x2122, 0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F,  /* 0x98 */
+	0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6, 0x00A7,  /* 0xA0 */
+	0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407,  /* 0xA8 */
+	0x00B0, 0x00B1, 0x0406, 0x0456, 0x0491, 0x00B5, 0x00B6, 0x00B7,  /* 0xB0 */
+	0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,  /* 0xB8 */
+	0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,  /* 0xC0 */
+	0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,  /* 0xC8 */
+	0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,  /* 0xD0 */
+	0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,  /* 0xD8 */
+	0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,  /* 0xE0 */
+	0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E, 0x043F,  /* 0xE8 */
+	0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,  /* 0xF0 */
+	0x0448, 0x0449, 0x044A, 0x044B, 0x044C, 0x044D, 0x044E, 0x044F,  /* 0xF8 */
+};
+
+static constexpr unsigned short windows_1252[128] = {
+	0x20AC, NOCHAR, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,  /* 0x80 */
+	0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, NOCHAR, 0x017D, NOCHAR,  /* 0x88 */
+	NOCHAR, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,  /* 0x90 */
+	0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, NOCHAR, 0x017E, 0x0178,  /* 0x98 */
+	0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,  /* 0xA0 */
+	0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,  /* 0xA8 */
+	0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,  /* 0xB0 */
+	0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,  /* 0xB8 */
+	0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,  /* 0xC0 */
+	0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,  /* 0xC8 */
+	0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,  /* 0xD0 */
+	0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,  /* 0xD8 */
+	0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,  /* 0xE0 */
+	0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,  /* 0xE8 */
+	0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,  /* 0xF0 */
+	0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,  /* 0xF8 */
+};
+
+static constexpr unsigned short koi8_r[128] = {
+	0x2500, 0x2502, 0x250C, 0x2510, 0x2514, 0x2518, 0x251C, 0x2524,  /* 0x80 */
+	0x252C, 0x2534, 0x253C, 0x2580, 0x2584, 0x2588, 0x258C, 0x2590,  /* 0x88 */
+	0x2591, 0x2592, 0x2593, 0x2320, 0x25A0, 0x2219, 0x221A, 0x2248,  /* 0x90 */
+	0x2264, 0x2265, 0x00A0, 0x2321, 0x00B0, 0x00B2, 0x00B7, 0x00F7,  /* 0x98 */
+	0x2550, 0x2551, 0x2552, 0x0451, 0x2553, 0x2554, 0x2555, 0x2556,  /* 0xA0 */
+	0x2557, 0x2558, 0x2559, 0x255A, 0x255B, 0x255C, 0x255D, 0x255E,  /* 0xA8 */
+	0x255F, 0x2560, 0x2561, 0x0401, 0x2562, 0x2563, 0x2564, 0x2565,  /* 0xB0 */
+	0x2566, 0x2567, 0x2568, 0x2569, 0x256A, 0x256B, 0x256C, 0x00A9,  /* 0xB8 */
+	0x044E, 0x0430, 0x0431, 0x0446, 0x0434, 0x0435, 0x0444, 0x0433,  /* 0xC0 */
+	0x0445, 0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E,  /* 0xC8 */
+	0x043F, 0x044F, 0x0440, 0x0441, 0x0442, 0x0443, 0x0436, 0x0432,  /* 0xD0 */
+	0x044C, 0x044B, 0x0437, 0x0448, 0x044D, 0x0449, 0x0447, 0x044A,  /* 0xD8 */
+	0x042E, 0x0410, 0x0411, 0x0426, 0x0414, 0x0415, 0x0424, 0x0413,  /* 0xE0 */
+	0x0425, 0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E,  /* 0xE8 */
+	0x041F, 0x042F, 0x0420, 0x0421, 0x0422, 0x0423, 0x0416, 0x0412,  /* 0xF0 */
+	0x042C, 0x042B, 0x0417, 0x0428, 0x042D, 0x0429, 0x0427, 0x042A,  /* 0xF8 */
+};
+/*
+ * The UTF-8 for each of the bytes 0x80 up to 0xFF is generated from the
+ * tables above at compile time: its bytes, with the length in the last
+ * one.  An undefined byte gets a '?' of length 1.  A NULL table is
+ * ISO-8859-1, where the byte is the code point.
+ */
+static constexpr unsigned int
+upper_code_point(const unsigned short *upper, unsigned int b)
+{
+	return upper == NULL ? 0x80 + b : upper[b];
+}
+
+static constexpr unsigned char
+utf8_byte(unsigned int u, unsigned int i)
+{
+	return
+		u == NOCHAR ? (i == 0 ? '?' : i == 3 ? 1 : 0) :
+		u < 0x800 ?
+			(i == 0 ? 0xC0 | (u >> 6) :
+			 i == 1 ? 0x80 | (u & 0x3F) :
+			 i == 3 ? 2 : 0) :
+			(i == 0 ? 0xE0 | (u >> 12) :
+			 i == 1 ? 0x80 | ((u >> 6) & 0x3F) :
+			 i == 2 ? 0x80 | (u & 0x3F) : 3);
+}
+
+/* expand the table from the bytes 0 .. 127 of the upper half */
+template<const unsigned short *U, unsigned int... B> struct Utf8Table {
+	static constexpr unsigned char utf8[sizeof...(B)][4] = {
+		{
+			utf8_byte(upper_code_point(U, B), 0),
+			utf8_byte(upper_code_point(U, B), 1),
+			utf8_byte(upper_code_point(U, B), 2),
+			utf8_byte(upper_code_point(U, B), 3)
+		}...
+	};
+};
+template<const unsigned short *U, unsigned int... B>
+constexpr unsigned char Utf8Table<U, B...>::utf8[sizeof...(B)][4];
+
+template<const unsigned short *U, unsigned int N, unsigned int... B>
+struct MakeUtf8Table : MakeUtf8Table<U, N - 1, N - 1, B...> {};
+template<const unsigned short *U, unsigned int... B>
+struct MakeUtf8Table<U, 0, B...> : Utf8Table<U, B...> {};
+
+struct charset {
+	const char *aliases[6];            /* upper case, without - and _ */
+	const unsigned char (*utf8)[4];    /* UTF-8 bytes, length */
+};
+
+static const struct charset charsets[] = {
+	{ { "ISO88591", "LATIN1", "L1", "CP819", "IBM819", NULL },
+		MakeUtf8Table<nullptr, 128>::utf8 },
+	{ { "ISO88592", "LATIN2", "L2", NULL },
+		MakeUtf8Table<iso8859_2, 128>::utf8 },
+	{ { "ISO885915", "LATIN9", "LATIN0", "L9", NULL },
+		MakeUtf8Table<iso8859_15, 128>::utf8 },
+	{ { "WINDOWS1250", "CP1250", "MSEE", NULL },
+		MakeUtf8Table<windows_1250, 128>::utf8 },
+	{ { "WINDOWS1251", "CP1251", "MSCYRL", NULL },
+		MakeUtf8Table<windows_1251, 128>::utf8 },
+	{ { "WINDOWS1252", "CP1252", "MSANSI", NULL },
+		MakeUtf8Table<windows_1252, 128>::utf8 },
+	{ { "KOI8R", NULL },
+		MakeUtf8Table<koi8_r, 128>::utf8 },
+};
+
+/*
+ * Upper case "name" into "norm" without any - and _, so "iso_8859-1"
+ * matches "ISO88591", stops at a // suffix, which is returned.
+ */
+static const char *
+charset_normalize(const char *name, char *norm, size_t normsze)
+{
+	size_t len = 0;
+
+	for (; *name != '\0'; name++) {
+		if (name[0] == '/' && name[1] == '/')
+			break;
+		if (*name == '-' || *name == '_')
+			continue;
+		if (len == normsze - 1 || !isalnum((unsigned char)*name)) {
+			len = 0;
+			break;
+		}
+		norm[len++] = toupper((unsigned char)*name);
+	}
+	norm[len] = '\0';
+
+	return name;
+}
+
+const struct charset *
+charset_find(const char *name)
+{
+	char norm[32];
+	size_t i;
+	size_t j;
+
+	/* anything with a //TRANSLIT or //IGNORE suffix is for iconv */
+	if (*charset_normalize(name, norm, sizeof(norm)) != '\0')
+		return NULL;
+
+	for (i = 0; i < nelems(charsets); i++) {
+		for (j = 0; charsets[i].aliases[j] != NULL; j++) {
+			if (strcmp(norm, charsets[i].aliases[j]) == 0)
+				return &charsets[i];
+		}
+	}
+
+	return NULL;
+}
+
+size_t
+charset_decode(const struct charset *cs,
+		const unsigned char *inp, size_t len, unsigned char *out,
+		size_t *replaced)
+{
+	const unsigned char *end = inp + len;
+	unsigned char *o = out;
+
+	while (inp < end) {
+		/* copy ASCII runs 8 bytes at a time */
+		while (end - inp >= 8) {
+			uint64_t w;
+
+			memcpy(&w, inp, sizeof(w));
+			if (w & 0x8080808080808080ULL)
+				break;
+			memcpy(o, &w, sizeof(w));
+			inp += 8;
+			o += 8;
+		}
+		if (inp == end)
+			break;
+
+		if (*inp < 0x80) {
+			*o++ = *inp++;
+		} else {
+			/* always copy all 4, the length in the last byte gets
+			 * overwritten by what follows */
+			const unsigned char *p = cs->utf8[*inp++ - 0x80];
+			memcpy(o, p, 4);
+			o += p[3];
+			/* only the '?' for undefined bytes is this short */
+			if (p[3] == 1)
+				(*replaced)++;
+		}
+	}
+
+	return o - out;
+}
+
+/*
+ * The HTML standard's prescan for a <meta> charset declaration, see
+ * https://html.spec.whatwg.org/multipage/parsing.html#prescan-a-byte-stream-to-determine-its-encoding
+ * It differs in that encoding labels are not resolved here, they are
+ * handed to charset_find() or iconv as they are.
+ */
+
+#define PRESCAN_SPACE(c) \
+	((c) == 0x09 || (c) == 0x0A || (c) == 0x0C || (c) == 0x0D || (c) == 0x20)
+
+/*
+ * Read an attribute starting at *pos into name and value, lowercased
+ * and truncated to their size, returns false when there are no more
+ * attributes in this tag.
+ */
+static bool
+prescan_attribute(const unsigned char *buf, size_t len, size_t *pos,
+		char *name, size_t namesze, char *value, size_t valuesze)
+{
+	size_t p = *pos;
+	size_t n = 0;
+	size_t v = 0;
+	unsigned char quote;
+
+	while (p < len && (PRESCAN_SPACE(buf[p]) || buf[p] == '/'))
+		p++;
+	if (p == len || buf[p] == '>') {
+		*pos = p;
+		return false;
+	}
+
+	/* the name, which may start with a = */
+	do {
+		if (n < namesze - 1)
+			name[n++] = tolower(buf[p]);
+		p++;
+	} while (p < len && buf[p] != '=' && buf[p] != '/' && buf[p] != '>' &&
+			!PRESCAN_SPACE(buf[p]));
+	name[n] = '\0';
+	value[0] = '\0';
+	while (p < len && PRESCAN_SPACE(buf[p]))
+		p++;
+	if (p == len || buf[p] != '=') {
+		*pos = p;
+		return true;
+	}
+	p++;
+
+	/* and its value */
+	while (p < len && PRESCAN_SPACE(buf[p]))
+		p++;
+	if (p < len && (buf[p] == '"' || buf[p] == '\'')) {
+		quote = buf[p++];
+		for (; p < len && buf[p] != quote; p++)
+			if (v < valuesze - 1)
+				value[v++] = tolower(buf[p]);
+		if (p < len)
+			p++;
+	} else {
+		for (; p < len && buf[p] != '>' && !PRESCAN_SPACE(buf[p]); p++)
+			if (v < valuesze - 1)
+				value[v++] = tolower(buf[p]);
+	}
+	value[v] = '\0';
+
+	*pos = p;
+	return true;
+}
+
+/*
+ * Take the charset from a content attribute like
+ * "text/html; charset=utf-8", returns false if there is none.
+ */
+static bool
+prescan_content_charset(const char *content, char *out, size_t outsze)
+{
+	const char *p = content;
+	size_t n = 0;
+
+	while ((p = strstr(p, "charset")) != NULL) {
+		p += sizeof("charset") - 1;
+		while (PRESCAN_SPACE(*p))
+			p++;
+		if (*p != '=')
+			continue;
+		p++;
+		while (PRESCAN_SPACE(*p))
+			p++;
+		if (*p == '"' || *p == '\'') {
+			const char *end = strchr(p + 1, *p);
+			if (end == NULL)
+				return false;
+			for (p++; p < end && n < outsze - 1; p++)
+				out[n++] = *p;
+		} else {
+			for (; *p != '\0' && *p != ';' && !PRESCAN_SPACE(*p) &&
+					n < outsze - 1; p++)
+				out[n++] = *p;
+		}
+		out[n] = '\0';
+		return n > 0;
+	}
+
+	return false;
+}
+
+bool
+charset_prescan(const unsigned char *buf, size_t len,
+		char *name, size_t namesze)
+{
+	size_t pos = 0;
+	char attr[16];
+	char value[128];
+
+	while (pos < len) {
+		if (buf[pos] != '<') {
+			pos++;
+			continue;
+		}
+
+		if (len - pos >= 4 && memcmp(buf + pos, "<!--", 4) == 0) {
+			/* the dashes of <!-- count towards its end too, so
+			 * <!--> is a comment */
+			for (pos += 2; pos + 2 < len; pos++)
+				if (buf[pos] == '-' && buf[pos + 1] == '-' &&
+						buf[pos + 2] == '>')
+					break;
+			pos += 3;
+		} else if (len - pos >= 6 && strncasecmp((const char *)buf + pos,
+					"<meta", 5) == 0 &&
+				(PRESCAN_SPACE(buf[pos + 5]) || buf[pos + 5] == '/'))
+		{
+			bool got_pragma = false;
+			bool seen_content = false;
+			bool seen_charset = false;
+			int need_pragma = -1;  /* unset */
+			char charset[sizeof(value)];
+
+			charset[0] = '\0';
+			pos += 6;
+			while (prescan_attribute(buf, len, &pos, attr, sizeof(attr),
+						value, sizeof(value)))
+			{
+				if (strcmp(attr, "http-equiv") == 0) {
+					if (strcmp(value, "content-type") == 0)
+						got_pragma = true;
+				} else if (strcmp(attr, "content") == 0) {
+					if (!seen_content && !seen_charset &&
+							prescan_content_charset(value,
+								charset, sizeof(charset)))
+					{
+						need_pragma = 1;
+					}
+					seen_content = true;
+				} else if (strcmp(attr, "charset") == 0) {
+					if (!seen_charset) {
+						snprintf(charset, sizeof(charset), "%s", value);
+						need_pragma = 0;
+					}
+					seen_charset = true;
+				}
+			}
+
+			if (need_pragma == -1 || (need_pragma == 1 && !got_pragma) ||
+					charset[0] == '\0')
+				continue;
+
+			/* a document that made it this far is no UTF-16 */
+			if (strncmp(charset, "utf-16", 6) == 0)
+				snprintf(charset, sizeof(charset), "UTF-8");
+			else if (strcmp(charset, "x-user-defined") == 0)
+				snprintf(charset, sizeof(charset), "WINDOWS-1252");
+			snprintf(name, namesze, "%s", charset);
+			return true;
+		} else if (len - pos >= 2 && (isalpha(buf[pos + 1]) ||
+					(buf[pos + 1] == '/' && len - pos >= 3 &&
+					 isalpha(buf[pos + 2]))))
+		{
+			/* any other tag, skip over its attributes, they can
+			 * contain a > */
+			for (pos++; pos < len && buf[pos] != '>' &&
+					!PRESCAN_SPACE(buf[pos]); pos++)
+				;
+			while (prescan_attribute(buf, len, &pos, attr, sizeof(attr),
+						value, sizeof(value)))
+				;
+		} else if (len - pos >= 2 && (buf[pos + 1] == '!' ||
+					buf[pos + 1] == '/' || buf[pos + 1] == '?'))
+		{
+			for (pos += 2; pos < len && buf[pos] != '>'; pos++)
+				;
+		} else {
+			pos++;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * ASCII replacements for everything beyond it, sorted by code point
+ * for bsearch.  This is glibc's transliteration table for the C locale
+ * (so -ascii output doesn't change from what iconv did), extended with
+ * the Latin letters with diacritics (which glibc only handles in real
+ * locales), combining marks, and any of our SGML entities that glibc
+ * has no replacement for.
+ */
+static constexpr struct translit {
+	unsigned int unicode;
+	const char *ascii;
+}
+translits[] = {
+	{ 0x00A0, " " }, { 0x00A1, "!" }, { 0x00A2, "c" }, { 0x00A3, "GBP" },
+	{ 0x00A5, "JPY" }, { 0x00A6, "|" }, { 0x00A7, "S" }, { 0x00A8, "\"" },
+	{ 0x00A9, "(C)" }, { 0x00AA, "a" }, { 0x00AB, "<<" }, { 0x00AD, "-" },
+	{ 0x00AE, "(R)" }, { 0x00AF, "-" }, { 0x00B0, "o" }, { 0x00B1, "+/-" },
+	{ 0x00B2, "^2" }, { 0x00B3, "^3" }, { 0x00B4, "'" }, { 0x00B5, "u" },
+	{ 0x00B6, "P" }, { 0x00B7, "." }, { 0x00B8, "," }, { 0x00B9, "^1" },
+	{ 0x00BA, "o" }, { 0x00BB, ">>" }, { 0x00BC, " 1/4 " },
+	{ 0x00BD, " 1/2 " }, { 0x00BE, " 3/4 " }, { 0x00BF, "?" },
+	{ 0x00C0, "A" }, { 0x00C1, "A" }, { 0x00C2, "A" }, { 0x00C3, "A" },
+	{ 0x00C4, "A" }, { 0x00C5, "A" }, { 0x00C6, "AE" }, { 0x00C7, "C" },
+	{ 0x00C8, "E" }, { 0x00C9, "E" }, { 0x00CA, "E" }, { 0x00CB, "E" },
+	{ 0x00CC, "I" }, { 0x00CD, "I" }, { 0x00CE, "I" }, { 0x00CF, "I" },
+	{ 0x00D0, "D" }, { 0x00D1, "N" }, { 0x00D2, "O" }, { 0x00D3, "O" },
+	{ 0x00D4, "O" }, { 0x00D5, "O" }, { 0x00D6, "O" }, { 0x00D7, "x" },
+	{ 0x00D8, "O" }, { 0x00D9, "U" }, { 0x00DA, "U" }, { 0x00DB, "U" },
+	{ 0x00DC, "U" }, { 0x00DD, "Y" }, { 0x00DE, "TH" }, { 0x00DF, "ss" },
+	{ 0x00E0, "a" }, { 0x00E1, "a" }, { 0x00E2, "a" }, { 0x00E3, "a" },
+	{ 0x00E4, "a" }, { 0x00E5, "a" }, { 0x00E6, "ae" }, { 0x00E7, "c" },
+	{ 0x00E8, "e" }, { 0x00E9, "e" }, { 0x00EA, "e" }, { 0x00EB, "e" },
+	{ 0x00EC, "i" }, { 0x00ED, "i" }, { 0x00EE, "i" }, { 0x00EF, "i" },
+	{ 0x00F0, "d" }, { 0x00F1, "n" }, { 0x00F2, "o" }, { 0x00F3, "o" },
+	{ 0x00F4, "o" }, { 0x00F5, "o" }, { 0x00F6, "o" }, { 0x00F7, ":" },
+	{ 0x00F8, "o" }, { 0x00F9, "u" }, { 0x00FA, "u" }, { 0x00FB, "u" },
+	{ 0x00FC, "u" }, { 0x00FD, "y" }, { 0x00FE, "th" }, { 0x00FF, "y" },
+	{ 0x0100, "A" }, { 0x0101, "a" }, { 0x0102, "A" }, { 0x0103, "a" },
+	{ 0x0104, "A" }, { 0x0105, "a" }, { 0x0106, "C" }, { 0x0107, "c" },
+	{ 0x0108, "C" }, { 0x0109, "c" }, { 0x010A, "C" }, { 0x010B, "c" },
+	{ 0x010C, "C" }, { 0x010D, "c" }, { 0x010E, "D" }, { 0x010F, "d" },
+	{ 0x0110, "D" }, { 0x0111, "d" }, { 0x0112, "E" }, { 0x0113, "e" },
+	{ 0x0114, "E" }, { 0x0115, "e" }, { 0x0116, "E" }, { 0x0117, "e" },
+	{ 0x0118, "E" }, { 0x0119, "e" }, { 0x011A, "E" }, { 0x011B, "e" },
+	{ 0x011C, "G" }, { 0x011D, "g" }, { 0x011E, "G" }, { 0x011F, "g" },
+	{ 0x0120, "G" }, { 0x0121, "g" }, { 0x0122, "G" }, { 0x0123, "g" },
+	{ 0x0124, "H" }, { 0x0125, "h" }, { 0x0126, "H" }, { 0x0127, "h" },
+	{ 0x0128, "I" }, { 0x0129, "i" }, { 0x012A, "I" }, { 0x012B, "i" },
+	{ 0x012C, "I" }, { 0x012D, "i" }, { 0x012E, "I" }, { 0x012F, "i" },
+	{ 0x0130, "I" }, { 0x0131, "i" }, { 0x0132, "IJ" }, { 0x0133, "ij" },
+	{ 0x0134, "J" }, { 0x0135, "j" }, { 0x0136, "K" }, { 0x0137, "k" },
+	{ 0x0138, "q" }, { 0x0139, "L" }, { 0x013A, "l" }, { 0x013B, "L" },
+	{ 0x013C, "l" }, { 0x013D, "L" }, { 0x013E, "l" }, { 0x013F, "L" },
+	{ 0x0140, "l" }, { 0x0141, "L" }, { 0x0142, "l" }, { 0x0143, "N" },
+	{ 0x0144, "n" }, { 0x0145, "N" }, { 0x0146, "n" }, { 0x0147, "N" },
+	{ 0x0148, "n" }, { 0x0149, "'n" }, { 0x014A, "N" }, { 0x014B, "n" },
+	{ 0x014C, "O" }, { 0x014D, "o" }, { 0x014E, "O" }, { 0x014F, "o" },
+	{ 0x0150, "O" }, { 0x0151, "o" }, { 0x0152, "OE" }, { 0x0153, "oe" },
+	{ 0x0154, "R" }, { 0x0155, "r" }, { 0x0156, "R" }, { 0x0157, "r" },
+	{ 0x0158, "R" }, { 0x0159, "r" }, { 0x015A, "S" }, { 0x015B, "s" },
+	{ 0x015C, "S" }, { 0x015D, "s" }, { 0x015E, "S" }, { 0x015F, "s" },
+	{ 0x0160, "S" }, { 0x0161, "s" }, { 0x0162, "T" }, { 0x0163, "t" },
+	{ 0x0164, "T" }, { 0x0165, "t" }, { 0x0166, "T" }, { 0x0167, "t" },
+	{ 0x0168, "U" }, { 0x0169, "u" }, { 0x016A, "U" }, { 0x016B, "u" },
+	{ 0x016C, "U" }, { 0x016D, "u" }, { 0x016E, "U" }, { 0x016F, "u" },
+	{ 0x0170, "U" }, { 0x0171, "u" }, { 0x0172, "U" }, { 0x0173, "u" },
+	{ 0x0174, "W" }, { 0x0175, "w" }, { 0x0176, "Y" }, { 0x0177, "y" },
+	{ 0x0178, "Y" }, { 0x0179, "Z" }, { 0x017A, "z" }, { 0x017B, "Z" },
+	{ 0x017C, "z" }, { 0x017D, "Z" }, { 0x017E, "z" }, { 0x017F, "s" },
+	{ 0x0180, "b" }, { 0x0192, "f" }, { 0x01A0, "O" }, { 0x01A1, "o" },
+	{ 0x01AF, "U" }, { 0x01B0, "u" }, { 0x01C7, "LJ" }, { 0x01C8, "Lj" },
+	{ 0x01C9, "lj" }, { 0x01CA, "NJ" }, { 0x01CB, "Nj" }, { 0x01CC, "nj" },
+	{ 0x01CD, "A" }, { 0x01CE, "a" }, { 0x01CF, "I" }, { 0x01D0, "i" },
+	{ 0x01D1, "O" }, { 0x01D2, "o" }, { 0x01D3, "U" }, { 0x01D4, "u" },
+	{ 0x01D5, "U" }, { 0x01D6, "u" }, { 0x01D7, "U" }, { 0x01D8, "u" },
+	{ 0x01D9, "U" }, { 0x01DA, "u" }, { 0x01DB, "U" }, { 0x01DC, "u" },
+	{ 0x01DE, "A" }, { 0x01DF, "a" }, { 0x01E0, "A" }, { 0x01E1, "a" },
+	{ 0x01E6, "G" }, { 0x01E7, "g" }, { 0x01E8, "K" }, { 0x01E9, "k" },
+	{ 0x01EA, "O" }, { 0x01EB, "o" }, { 0x01EC, "O" }, { 0x01ED, "o" },
+	{ 0x01F0, "j" }, { 0x01F1, "DZ" }, { 0x01F2, "Dz" }, { 0x01F3, "dz" },
+	{ 0x01F4, "G" }, { 0x01F5, "g" }, { 0x01F8, "N" }, { 0x01F9, "n" },
+	{ 0x01FA, "A" }, { 0x01FB, "a" }, { 0x0200, "A" }, { 0x0201, "a" },
+	{ 0x0202, "A" }, { 0x0203, "a" }, { 0x0204, "E" }, { 0x0205, "e" },
+	{ 0x0206, "E" }, { 0x0207, "e" }, { 0x0208, "I" }, { 0x0209, "i" },
+	{ 0x020A, "I" }, { 0x020B, "i" }, { 0x020C, "O" }, { 0x020D, "o" },
+	{ 0x020E, "O" }, { 0x020F, "o" }, { 0x0210, "R" }, { 0x0211, "r" },
+	{ 0x0212, "R" }, { 0x0213, "r" }, { 0x0214, "U" }, { 0x0215, "u" },
+	{ 0x0216, "U" }, { 0x0217, "u" }, { 0x0218, "S" }, { 0x0219, "s" },
+	{ 0x021A, "T" }, { 0x021B, "t" }, { 0x021E, "H" }, { 0x021F, "h" },
+	{ 0x0226, "A" }, { 0x0227, "a" }, { 0x0228, "E" }, { 0x0229, "e" },
+	{ 0x022A, "O" }, { 0x022B, "o" }, { 0x022C, "O" }, { 0x022D, "o" },
+	{ 0x022E, "O" }, { 0x022F, "o" }, { 0x0230, "O" }, { 0x0231, "o" },
+	{ 0x0232, "Y" }, { 0x0233, "y" }, { 0x02BC, "'" }, { 0x02C6, "^" },
+	{ 0x02C8, "'" }, { 0x02CB, "`" }, { 0x02CD, "_" }, { 0x02D0, ":" },
+	{ 0x02DC, "~" }, { 0x0300, "" }, { 0x0301, "" }, { 0x0302, "" },
+	{ 0x0303, "" }, { 0x0304, "" }, { 0x0305, "" }, { 0x0306, "" },
+	{ 0x0307, "" }, { 0x0308, "" }, { 0x0309, "" }, { 0x030A, "" },
+	{ 0x030B, "" }, { 0x030C, "" }, { 0x030D, "" }, { 0x030E, "" },
+	{ 0x030F, "" }, { 0x0310, "" }, { 0x0311, "" }, { 0x0312, "" },
+	{ 0x0313, "" }, { 0x0314, "" }, { 0x0315, "" }, { 0x0316, "" },
+	{ 0x0317, "" }, { 0x0318, "" }, { 0x0319, "" }, { 0x031A, "" },
+	{ 0x031B, "" }, { 0x031C, "" }, { 0x031D, "" }, { 0x031E, "" },
+	{ 0x031F, "" }, { 0x0320, "" }, { 0x0321, "" }, { 0x0322, "" },
+	{ 0x0323, "" }, { 0x0324, "" }, { 0x0325, "" }, { 0x0326, "" },
+	{ 0x0327, "" }, { 0x0328, "" }, { 0x0329, "" }, { 0x032A, "" },
+	{ 0x032B, "" }, { 0x032C, "" }, { 0x032D, "" }, { 0x032E, "" },
+	{ 0x032F, "" }, { 0x0330, "" }, { 0x0331, "" }, { 0x0332, "" },
+	{ 0x0333, "" }, { 0x0334, "" }, { 0x0335, "" }, { 0x0336, "" },
+	{ 0x0337, "" }, { 0x0338, "" }, { 0x0339, "" }, { 0x033A, "" },
+	{ 0x033B, "" }, { 0x033C, "" }, { 0x033D, "" }, { 0x033E, "" },
+	{ 0x033F, "" }, { 0x0340, "" }, { 0x0341, "" }, { 0x0342, "" },
+	{ 0x0343, "" }, { 0x0344, "" }, { 0x0345, "" }, { 0x0346, "" },
+	{ 0x0347, "" }, { 0x0348, "" }, { 0x0349, "" }, { 0x034A, "" },
+	{ 0x034B, "" }, { 0x034C, "" }, { 0x034D, "" }, { 0x034E, "" },
+	{ 0x0350, "" }, { 0x0351, "" }, { 0x0352, "" }, { 0x0353, "" },
+	{ 0x0354, "" }, { 0x0355, "" }, { 0x0356, "" }, { 0x0357, "" },
+	{ 0x0358, "" }, { 0x0359, "" }, { 0x035A, "" }, { 0x035B, "" },
+	{ 0x035C, "" }, { 0x035D, "" }, { 0x035E, "" }, { 0x035F, "" },
+	{ 0x0360, "" }, { 0x0361, "" }, { 0x0362, "" }, { 0x0363, "" },
+	{ 0x0364, "" }, { 0x0365, "" }, { 0x0366, "" }, { 0x0367, "" },
+	{ 0x0368, "" }, { 0x0369, "" }, { 0x036A, "" }, { 0x036B, "" },
+	{ 0x036C, "" }, { 0x036D, "" }, { 0x036E, "" }, { 0x036F, "" },
+	{ 0x0370, "H" }, { 0x0371, "h" }, { 0x0372, "SS" }, { 0x0373, "ss" },
+	{ 0x0374, "#" }, { 0x0375, "#`" }, { 0x0376, "W" }, { 0x0377, "w" },
+	{ 0x037A, "i" }, { 0x037B, "s" }, { 0x037C, "s" }, { 0x037D, "s" },
+	{ 0x037F, "J" }, { 0x0384, "`" }, { 0x0385, "`" }, { 0x0386, "A" },
+	{ 0x0387, ";" }, { 0x0388, "E" }, { 0x0389, "I" }, { 0x038A, "I" },
+	{ 0x038C, "O" }, { 0x038E, "Y" }, { 0x038F, "O" }, { 0x0390, "I" },
+	{ 0x0391, "A" }, { 0x0392, "V" }, { 0x0393, "G" }, { 0x0394, "D" },
+	{ 0x0395, "E" }, { 0x0396, "Z" }, { 0x0397, "I" }, { 0x0398, "TH" },
+	{ 0x0399, "I" }, { 0x039A, "K" }, { 0x039B, "L" }, { 0x039C, "M" },
+	{ 0x039D, "N" }, { 0x039E, "X" }, { 0x039F, "O" }, { 0x03A0, "P" },
+	{ 0x03A1, "R" }, { 0x03A3, "S" }, { 0x03A4, "T" }, { 0x03A5, "Y" },
+	{ 0x03A6, "F" }, { 0x03A7, "CH" }, { 0x03A8, "PS" }, { 0x03A9, "O" },
+	{ 0x03AA, "I" }, { 0x03AB, "Y" }, { 0x03AC, "a" }, { 0x03AD, "e" },
+	{ 0x03AE, "i" }, { 0x03AF, "i" }, { 0x03B0, "y" }, { 0x03B1, "a" },
+	{ 0x03B2, "v" }, { 0x03B3, "g" }, { 0x03B4, "d" }, { 0x03B5, "e" },
+	{ 0x03B6, "z" }, { 0x03B7, "i" }, { 0x03B8, "th" }, { 0x03B9, "i" },
+	{ 0x03BA, "k" }, { 0x03BB, "l" }, { 0x03BC, "m" }, { 0x03BD, "n" },
+	{ 0x03BE, "x" }, { 0x03BF, "o" }, { 0x03C0, "p" }, { 0x03C1, "r" },
+	{ 0x03C2, "s" }, { 0x03C3, "s" }, { 0x03C4, "t" }, { 0x03C5, "y" },
+	{ 0x03C6, "f" }, { 0x03C7, "ch" }, { 0x03C8, "ps" }, { 0x03C9, "o" },
+	{ 0x03CA, "i" }, { 0x03CB, "y" }, { 0x03CC, "o" }, { 0x03CD, "y" },
+	{ 0x03CE, "o" }, { 0x03CF, "&" }, { 0x03D0, "b" }, { 0x03D1, "th" },
+	{ 0x03D2, "Y`" }, { 0x03D3, "Y`" }, { 0x03D4, "Y`" }, { 0x03D5, "f" },
+	{ 0x03D6, "p" }, { 0x03D7, "&" }, { 0x03D8, "Q" }, { 0x03D9, "q" },
+	{ 0x03DA, "6" }, { 0x03DB, "6" }, { 0x03DC, "W" }, { 0x03DD, "w" },
+	{ 0x03DE, "90" }, { 0x03DF, "90" }, { 0x03E0, "900" },
+	{ 0x03E1, "900" }, { 0x03E2, "SH" }, { 0x03E3, "sh" }, { 0x03E4, "F" },
+	{ 0x03E5, "f" }, { 0x03E6, "KH" }, { 0x03E7, "kh" }, { 0x03E8, "H" },
+	{ 0x03E9, "h" }, { 0x03EA, "DJ" }, { 0x03EB, "dj" }, { 0x03EC, "GJ" },
+	{ 0x03ED, "gj" }, { 0x03EE, "TI" }, { 0x03EF, "ti" }, { 0x03F0, "k" },
+	{ 0x03F1, "r" }, { 0x03F2, "s" }, { 0x03F3, "j" }, { 0x03F4, "TH" },
+	{ 0x03F5, "e" }, { 0x03F6, "e" }, { 0x03F7, "SH" }, { 0x03F8, "sh" },
+	{ 0x03F9, "S" }, { 0x03FA, "S" }, { 0x03FB, "s" }, { 0x03FC, "r" },
+	{ 0x03FD, "S" }, { 0x03FE, "S" }, { 0x03FF, "S" }, { 0x0401, "YO" },
+	{ 0x0402, "DJ" }, { 0x0403, "G`" }, { 0x0404, "YE" }, { 0x0405, "Z`" },
+	{ 0x0406, "I" }, { 0x0407, "YI" }, { 0x0408, "J" }, { 0x0409, "L`" },
+	{ 0x040A, "N`" }, { 0x040B, "TSH" }, { 0x040C, "K`" },
+	{ 0x040E, "U`" }, { 0x040F, "DH" }, { 0x0410, "A" }, { 0x0411, "B" },
+	{ 0x0412, "V" }, { 0x0413, "G" }, { 0x0414, "D" }, { 0x0415, "E" },
+	{ 0x0416, "ZH" }, { 0x0417, "Z" }, { 0x0418, "I" }, { 0x0419, "J" },
+	{ 0x041A, "K" }, { 0x041B, "L" }, { 0x041C, "M" }, { 0x041D, "N" },
+	{ 0x041E, "O" }, { 0x041F, "P" }, { 0x0420, "R" }, { 0x0421, "S" },
+	{ 0x0422, "T" }, { 0x0423, "U" }, { 0x0424, "F" }, { 0x0425, "X" },
+	{ 0x0426, "CZ" }, { 0x0427, "CH" }, { 0x0428, "SH" },
+	{ 0x0429, "SHH" }, { 0x042A, "A`" }, { 0x042B, "Y`" }, { 0x042C, "`" },
+	{ 0x042D, "E`" }, { 0x042E, "YU" }, { 0x042F, "YA" }, { 0x0430, "a" },
+	{ 0x0431, "b" }, { 0x0432, "v" }, { 0x0433, "g" }, { 0x0434, "d" },
+	{ 0x0435, "e" }, { 0x0436, "zh" }, { 0x0437, "z" }, { 0x0438, "i" },
+	{ 0x0439, "j" }, { 0x043A, "k" }, { 0x043B, "l" }, { 0x043C, "m" },
+	{ 0x043D, "n" }, { 0x043E, "o" }, { 0x043F, "p" }, { 0x0440, "r" },
+	{ 0x0441, "s" }, { 0x0442, "t" }, { 0x0443, "u" }, { 0x0444, "f" },
+	{ 0x0445, "x" }, { 0x0446, "cz" }, { 0x0447, "ch" }, { 0x0448, "sh" },
+	{ 0x0449, "shh" }, { 0x044A, "``" }, { 0x044B, "y`" }, { 0x044C, "`" },
+	{ 0x044D, "e`" }, { 0x044E, "yu" }, { 0x044F, "ya" }, { 0x0451, "yo" },
+	{ 0x0452, "dj" }, { 0x0453, "g`" }, { 0x0454, "ye" }, { 0x0455, "z`" },
+	{ 0x0456, "i" }, { 0x0457, "yi" }, { 0x0458, "j" }, { 0x0459, "l`" },
+	{ 0x045A, "n`" }, { 0x045B, "tsh" }, { 0x045C, "k`" },
+	{ 0x045E, "u`" }, { 0x045F, "dh" }, { 0x046A, "O`" }, { 0x046B, "o`" },
+	{ 0x0472, "FH" }, { 0x0473, "fh" }, { 0x0474, "YH" }, { 0x0475, "yh" },
+	{ 0x048C, "E`" }, { 0x048D, "e`" }, { 0x0490, "G`" }, { 0x0491, "g`" },
+	{ 0x0492, "GH" }, { 0x0493, "gh" }, { 0x0494, "GH" }, { 0x0495, "gh" },
+	{ 0x0496, "ZH`" }, { 0x0497, "zh`" }, { 0x049A, "K`" },
+	{ 0x049B, "k`" }, { 0x049E, "K`" }, { 0x049F, "k`" }, { 0x04A2, "N`" },
+	{ 0x04A3, "n`" }, { 0x04A4, "NG" }, { 0x04A5, "ng" }, { 0x04A6, "P`" },
+	{ 0x04A7, "p`" }, { 0x04A8, "O`" }, { 0x04A9, "o`" }, { 0x04AA, "C`" },
+	{ 0x04AB, "C`" }, { 0x04AC, "T`" }, { 0x04AD, "t`" }, { 0x04AE, "U" },
+	{ 0x04AF, "u" }, { 0x04B2, "H`" }, { 0x04B3, "h`" }, { 0x04B4, "TCZ" },
+	{ 0x04B5, "tcz" }, { 0x04BA, "SH`" }, { 0x04BB, "sh`" },
+	{ 0x04BC, "CH`" }, { 0x04BD, "ch`" }, { 0x04BE, "CH`" },
+	{ 0x04BF, "ch`" }, { 0x04C0, "i" }, { 0x04C1, "ZH`" },
+	{ 0x04C2, "zh`" }, { 0x04CB, "CH`" }, { 0x04CC, "ch`" },
+	{ 0x04D0, "A`" }, { 0x04D1, "a`" }, { 0x04D2, "A`" }, { 0x04D3, "a`" },
+	{ 0x04D6, "E`" }, { 0x04D7, "e`" }, { 0x04D8, "A`" }, { 0x04D9, "a`" },
+	{ 0x04DC, "ZH`" }, { 0x04DD, "zh`" }, { 0x04DE, "Z`" },
+	{ 0x04DF, "z`" }, { 0x04E0, "Z`" }, { 0x04E1, "z`" }, { 0x04E4, "I`" },
+	{ 0x04E5, "i`" }, { 0x04E6, "O`" }, { 0x04E7, "o`" }, { 0x04E8, "O`" },
+	{ 0x04E9, "o`" }, { 0x04F0, "U`" }, { 0x04F1, "u`" }, { 0x04F2, "U`" },
+	{ 0x04F3, "u`" }, { 0x04F4, "CH`" }, { 0x04F5, "ch`" },
+	{ 0x04F8, "Y`" }, { 0x04F9, "y`" }, { 0x05F3, "'" }, { 0x05F4, "\"" },
+	{ 0x1E00, "A" }, { 0x1E01, "a" }, { 0x1E02, "B" }, { 0x1E03, "b" },
+	{ 0x1E04, "B" }, { 0x1E05, "b" }, { 0x1E06, "B" }, { 0x1E07, "b" },
+	{ 0x1E08, "C" }, { 0x1E09, "c" }, { 0x1E0A, "D" }, { 0x1E0B, "d" },
+	{ 0x1E0C, "D" }, { 0x1E0D, "d" }, { 0x1E0E, "D" }, { 0x1E0F, "d" },
+	{ 0x1E10, "D" }, { 0x1E11, "d" }, { 0x1E12, "D" }, { 0x1E13, "d" },
+	{ 0x1E14, "E" }, { 0x1E15, "e" }, { 0x1E16, "E" }, { 0x1E17, "e" },
+	{ 0x1E18, "E" }, { 0x1E19, "e" }, { 0x1E1A, "E" }, { 0x1E1B, "e" },
+	{ 0x1E1C, "E" }, { 0x1E1D, "e" }, { 0x1E1E, "F" }, { 0x1E1F, "f" },
+	{ 0x1E20, "G" }, { 0x1E21, "g" }, { 0x1E22, "H" }, { 0x1E23, "h" },
+	{ 0x1E24, "H" }, { 0x1E25, "h" }, { 0x1E26, "H" }, { 0x1E27, "h" },
+	{ 0x1E28, "H" }, { 0x1E29, "h" }, { 0x1E2A, "H" }, { 0x1E2B, "h" },
+	{ 0x1E2C, "I" }, { 0x1E2D, "i" }, { 0x1E2E, "I" }, { 0x1E2F, "i" },
+	{ 0x1E30, "K" }, { 0x1E31, "k" }, { 0x1E32, "K" }, { 0x1E33, "k" },
+	{ 0x1E34, "K" }, { 0x1E35, "k" }, { 0x1E36, "L" }, { 0x1E37, "l" },
+	{ 0x1E38, "L" }, { 0x1E39, "l" }, { 0x1E3A, "L" }, { 0x1E3B, "l" },
+	{ 0x1E3C, "L" }, { 0x1E3D, "l" }, { 0x1E3E, "M" }, { 0x1E3F, "m" },
+	{ 0x1E40, "M" }, { 0x1E41, "m" }, { 0x1E42, "M" }, { 0x1E43, "m" },
+	{ 0x1E44, "N" }, { 0x1E45, "n" }, { 0x1E46, "N" }, { 0x1E47, "n" },
+	{ 0x1E48, "N" }, { 0x1E49, "n" }, { 0x1E4A, "N" }, { 0x1E4B, "n" },
+	{ 0x1E4C, "O" }, { 0x1E4D, "o" }, { 0x1E4E, "O" }, { 0x1E4F, "o" },
+	{ 0x1E50, "O" }, { 0x1E51, "o" }, { 0x1E52, "O" }, { 0x1E53, "o" },
+	{ 0x1E54, "P" }, { 0x1E55, "p" }, { 0x1E56, "P" }, { 0x1E57, "p" },
+	{ 0x1E58, "R" }, { 0x1E59, "r" }, { 0x1E5A, "R" }, { 0x1E5B, "r" },
+	{ 0x1E5C, "R" }, { 0x1E5D, "r" }, { 0x1E5E, "R" }, { 0x1E5F, "r" },
+	{ 0x1E60, "S" }, { 0x1E61, "s" }, { 0x1E62, "S" }, { 0x1E63, "s" },
+	{ 0x1E64, "S" }, { 0x1E65, "s" }, { 0x1E66, "S" }, { 0x1E67, "s" },
+	{ 0x1E68, "S" }, { 0x1E69, "s" }, { 0x1E6A, "T" }, { 0x1E6B, "t" },
+	{ 0x1E6C, "T" }, { 0x1E6D, "t" }, { 0x1E6E, "T" }, { 0x1E6F, "t" },
+	{ 0x1E70, "T" }, { 0x1E71, "t" }, { 0x1E72, "U" }, { 0x1E73, "u" },
+	{ 0x1E74, "U" }, { 0x1E75, "u" }, { 0x1E76, "U" }, { 0x1E77, "u" },
+	{ 0x1E78, "U" }, { 0x1E79, "u" }, { 0x1E7A, "U" }, { 0x1E7B, "u" },
+	{ 0x1E7C, "V" }, { 0x1E7D, "v" }, { 0x1E7E, "V" }, { 0x1E7F, "v" },
+	{ 0x1E80, "W" }, { 0x1E81, "w" }, { 0x1E82, "W" }, { 0x1E83, "w" },
+	{ 0x1E84, "W" }, { 0x1E85, "w" }, { 0x1E86, "W" }, { 0x1E87, "w" },
+	{ 0x1E88, "W" }, { 0x1E89, "w" }, { 0x1E8A, "X" }, { 0x1E8B, "x" },
+	{ 0x1E8C, "X" }, { 0x1E8D, "x" }, { 0x1E8E, "Y" }, { 0x1E8F, "y" },
+	{ 0x1E90, "Z" }, { 0x1E91, "z" }, { 0x1E92, "Z" }, { 0x1E93, "z" },
+	{ 0x1E94, "Z" }, { 0x1E95, "z" }, { 0x1E96, "h" }, { 0x1E97, "t" },
+	{ 0x1E98, "w" }, { 0x1E99, "y" }, { 0x1EA0, "A" }, { 0x1EA1, "a" },
+	{ 0x1EA2, "A" }, { 0x1EA3, "a" }, { 0x1EA4, "A" }, { 0x1EA5, "a" },
+	{ 0x1EA6, "A" }, { 0x1EA7, "a" }, { 0x1EA8, "A" }, { 0x1EA9, "a" },
+	{ 0x1EAA, "A" }, { 0x1EAB, "a" }, { 0x1EAC, "A" }, { 0x1EAD, "a" },
+	{ 0x1EAE, "A" }, { 0x1EAF, "a" }, { 0x1EB0, "A" }, { 0x1EB1, "a" },
+	{ 0x1EB2, "A" }, { 0x1EB3, "a" }, { 0x1EB4, "A" }, { 0x1EB5, "a" },
+	{ 0x1EB6, "A" }, { 0x1EB7, "a" }, { 0x1EB8, "E" }, { 0x1EB9, "e" },
+	{ 0x1EBA, "E" }, { 0x1EBB, "e" }, { 0x1EBC, "E" }, { 0x1EBD, "e" },
+	{ 0x1EBE, "E" }, { 0x1EBF, "e" }, { 0x1EC0, "E" }, { 0x1EC1, "e" },
+	{ 0x1EC2, "E" }, { 0x1EC3, "e" }, { 0x1EC4, "E" }, { 0x1EC5, "e" },
+	{ 0x1EC6, "E" }, { 0x1EC7, "e" }, { 0x1EC8, "I" }, { 0x1EC9, "i" },
+	{ 0x1ECA, "I" }, { 0x1ECB, "i" }, { 0x1ECC, "O" }, { 0x1ECD, "o" },
+	{ 0x1ECE, "O" }, { 0x1ECF, "o" }, { 0x1ED0, "O" }, { 0x1ED1, "o" },
+	{ 0x1ED2, "O" }, { 0x1ED3, "o" }, { 0x1ED4, "O" }, { 0x1ED5, "o" },
+	{ 0x1ED6, "O" }, { 0x1ED7, "o" }, { 0x1ED8, "O" }, { 0x1ED9, "o" },
+	{ 0x1EDA, "O" }, { 0x1EDB, "o" }, { 0x1EDC, "O" }, { 0x1EDD, "o" },
+	{ 0x1EDE, "O" }, { 0x1EDF, "o" }, { 0x1EE0, "O" }, { 0x1EE1, "o" },
+	{ 0x1EE2, "O" }, { 0x1EE3, "o" }, { 0x1EE4, "U" }, { 0x1EE5, "u" },
+	{ 0x1EE6, "U" }, { 0x1EE7, "u" }, { 0x1EE8, "U" }, { 0x1EE9, "u" },
+	{ 0x1EEA, "U" }, { 0x1EEB, "u" }, { 0x1EEC, "U" }, { 0x1EED, "u" },
+	{ 0x1EEE, "U" }, { 0x1EEF, "u" }, { 0x1EF0, "U" }, { 0x1EF1, "u" },
+	{ 0x1EF2, "Y" }, { 0x1EF3, "y" }, { 0x1EF4, "Y" }, { 0x1EF5, "y" },
+	{ 0x1EF6, "Y" }, { 0x1EF7, "y" }, { 0x1EF8, "Y" }, { 0x1EF9, "y" },
+	{ 0x2002, " " }, { 0x2003, " " }, { 0x2004, " " }, { 0x2005, " " },
+	{ 0x2006, " " }, { 0x2008, " " }, { 0x2009, " " }, { 0x200A, " " },
+	{ 0x200B, "" }, { 0x200C, "" }, { 0x200D, "" }, { 0x200E, "" },
+	{ 0x200F, "" }, { 0x2010, "-" }, { 0x2011, "-" }, { 0x2012, "-" },
+	{ 0x2013, "-" }, { 0x2014, "--" }, { 0x2015, "-" }, { 0x2018, "'" },
+	{ 0x2019, "'" }, { 0x201A, "," }, { 0x201B, "'" }, { 0x201C, "\"" },
+	{ 0x201D, "\"" }, { 0x201E, ",," }, { 0x201F, "\"" }, { 0x2020, "+" },
+	{ 0x2022, "o" }, { 0x2024, "." }, { 0x2025, ".." }, { 0x2026, "..." },
+	{ 0x202F, " " }, { 0x2030, "0/00" }, { 0x2032, "'" }, { 0x2033, "\"" },
+	{ 0x2035, "`" }, { 0x2036, "``" }, { 0x2037, "```" }, { 0x2039, "<" },
+	{ 0x203A, ">" }, { 0x203C, "!!" }, { 0x203E, "-" }, { 0x2044, "/" },
+	{ 0x2047, "??" }, { 0x2048, "?!" }, { 0x2049, "!?" }, { 0x204E, "*" },
+	{ 0x205F, " " }, { 0x2060, "" }, { 0x2061, "" }, { 0x2062, "" },
+	{ 0x2063, "" }, { 0x20A1, "C=" }, { 0x20A8, "Rs" }, { 0x20AC, "EUR" },
+	{ 0x20B9, "INR" }, { 0x2100, "a/c" }, { 0x2101, "a/s" },
+	{ 0x2102, "C" }, { 0x2105, "c/o" }, { 0x2106, "c/u" }, { 0x210A, "g" },
+	{ 0x210B, "H" }, { 0x210C, "H" }, { 0x210D, "H" }, { 0x210E, "h" },
+	{ 0x2110, "I" }, { 0x2111, "I" }, { 0x2112, "L" }, { 0x2113, "l" },
+	{ 0x2115, "N" }, { 0x2116, "No" }, { 0x2118, "P" }, { 0x2119, "P" },
+	{ 0x211A, "Q" }, { 0x211B, "R" }, { 0x211C, "R" }, { 0x211D, "R" },
+	{ 0x2121, "TEL" }, { 0x2122, "(TM)" }, { 0x2124, "Z" },
+	{ 0x2126, "Ohm" }, { 0x2128, "Z" }, { 0x212C, "B" }, { 0x212D, "C" },
+	{ 0x212E, "e" }, { 0x212F, "e" }, { 0x2130, "E" }, { 0x2131, "F" },
+	{ 0x2133, "M" }, { 0x2134, "o" }, { 0x2135, "N" }, { 0x2139, "i" },
+	{ 0x2145, "D" }, { 0x2146, "d" }, { 0x2147, "e" }, { 0x2148, "i" },
+	{ 0x2149, "j" }, { 0x2153, " 1/3 " }, { 0x2154, " 2/3 " },
+	{ 0x2155, " 1/5 " }, { 0x2156, " 2/5 " }, { 0x2157, " 3/5 " },
+	{ 0x2158, " 4/5 " }, { 0x2159, " 1/6 " }, { 0x215A, " 5/6 " },
+	{ 0x215B, " 1/8 " }, { 0x215C, " 3/8 " }, { 0x215D, " 5/8 " },
+	{ 0x215E, " 7/8 " }, { 0x215F, " 1/" }, { 0x2160, "I" },
+	{ 0x2161, "II" }, { 0x2162, "III" }, { 0x2163, "IV" }, { 0x2164, "V" },
+	{ 0x2165, "VI" }, { 0x2166, "VII" }, { 0x2167, "VIII" },
+	{ 0x2168, "IX" }, { 0x2169, "X" }, { 0x216A, "XI" }, { 0x216B, "XII" },
+	{ 0x216C, "L" }, { 0x216D, "C" }, { 0x216E, "D" }, { 0x216F, "M" },
+	{ 0x2170, "i" }, { 0x2171, "ii" }, { 0x2172, "iii" }, { 0x2173, "iv" },
+	{ 0x2174, "v" }, { 0x2175, "vi" }, { 0x2176, "vii" },
+	{ 0x2177, "viii" }, { 0x2178, "ix" }, { 0x2179, "x" },
+	{ 0x217A, "xi" }, { 0x217B, "xii" }, { 0x217C, "l" }, { 0x217D, "c" },
+	{ 0x217E, "d" }, { 0x217F, "m" }, { 0x2190, "<-" }, { 0x2191, "^" },
+	{ 0x2192, "->" }, { 0x2193, "v" }, { 0x2194, "<->" }, { 0x21A1, "v" },
+	{ 0x21B5, "<-" }, { 0x21D0, "<=" }, { 0x21D1, "^" }, { 0x21D2, "=>" },
+	{ 0x21D3, "v" }, { 0x21D4, "<=>" }, { 0x2200, "A" }, { 0x2202, "d" },
+	{ 0x2203, "E" }, { 0x2205, "0" }, { 0x2207, "V" }, { 0x2208, "E" },
+	{ 0x2209, "!E" }, { 0x220A, "E" }, { 0x220B, "3" }, { 0x220D, "3" },
+	{ 0x220F, "P" }, { 0x2211, "E" }, { 0x2212, "-" }, { 0x2215, "/" },
+	{ 0x2216, "\\" }, { 0x2217, "*" }, { 0x221A, "V" }, { 0x221D, "~" },
+	{ 0x221E, "oo" }, { 0x2220, "<" }, { 0x2223, "|" }, { 0x2227, "/\\" },
+	{ 0x2228, "\\/" }, { 0x2229, "^" }, { 0x222A, "U" }, { 0x222B, "S" },
+	{ 0x2234, ":." }, { 0x2236, ":" }, { 0x223C, "~" }, { 0x2245, "=~" },
+	{ 0x2248, "~=" }, { 0x2260, "!=" }, { 0x2261, "==" }, { 0x2264, "<=" },
+	{ 0x2265, ">=" }, { 0x226A, "<<" }, { 0x226B, ">>" }, { 0x2282, "(" },
+	{ 0x2283, ")" }, { 0x2284, "!(" }, { 0x2286, "(=" }, { 0x2287, ")=" },
+	{ 0x2295, "(+)" }, { 0x2297, "(x)" }, { 0x22A5, "_|_" },
+	{ 0x22C5, "." }, { 0x22D8, "<<<" }, { 0x22D9, ">>>" }, { 0x2308, "[" },
+	{ 0x2309, "]" }, { 0x230A, "[" }, { 0x230B, "]" }, { 0x2329, "<" },
+	{ 0x232A, ">" }, { 0x2400, "NUL" }, { 0x2401, "SOH" },
+	{ 0x2402, "STX" }, { 0x2403, "ETX" }, { 0x2404, "EOT" },
+	{ 0x2405, "ENQ" }, { 0x2406, "ACK" }, { 0x2407, "BEL" },
+	{ 0x2408, "BS" }, { 0x2409, "HT" }, { 0x240A, "LF" }, { 0x240B, "VT" },
+	{ 0x240C, "FF" }, { 0x240D, "CR" }, { 0x240E, "SO" }, { 0x240F, "SI" },
+	{ 0x2410, "DLE" }, { 0x2411, "DC1" }, { 0x2412, "DC2" },
+	{ 0x2413, "DC3" }, { 0x2414, "DC4" }, { 0x2415, "NAK" },
+	{ 0x2416, "SYN" }, { 0x2417, "ETB" }, { 0x2418, "CAN" },
+	{ 0x2419, "EM" }, { 0x241A, "SUB" }, { 0x241B, "ESC" },
+	{ 0x241C, "FS" }, { 0x241D, "GS" }, { 0x241E, "RS" }, { 0x241F, "US" },
+	{ 0x2420, "SP" }, { 0x2421, "DEL" }, { 0x2423, "_" }, { 0x2424, "NL" },
+	{ 0x2460, "(1)" }, { 0x2461, "(2)" }, { 0x2462, "(3)" },
+	{ 0x2463, "(4)" }, { 0x2464, "(5)" }, { 0x2465, "(6)" },
+	{ 0x2466, "(7)" }, { 0x2467, "(8)" }, { 0x2468, "(9)" },
+	{ 0x2469, "(10)" }, { 0x246A, "(11)" }, { 0x246B, "(12)" },
+	{ 0x246C, "(13)" }, { 0x246D, "(14)" }, { 0x246E, "(15)" },
+	{ 0x246F, "(16)" }, { 0x2470, "(17)" }, { 0x2471, "(18)" },
+	{ 0x2472, "(19)" }, { 0x2473, "(20)" }, { 0x2474, "(1)" },
+	{ 0x2475, "(2)" }, { 0x2476, "(3)" }, { 0x2477, "(4)" },
+	{ 0x2478, "(5)" }, { 0x2479, "(6)" }, { 0x247A, "(7)" },
+	{ 0x247B, "(8)" }, { 0x247C, "(9)" }, { 0x247D, "(10)" },
+	{ 0x247E, "(11)" }, { 0x247F, "(12)" }, { 0x2480, "(13)" },
+	{ 0x2481, "(14)" }, { 0x2482, "(15)" }, { 0x2483, "(16)" },
+	{ 0x2484, "(17)" }, { 0x2485, "(18)" }, { 0x2486, "(19)" },
+	{ 0x2487, "(20)" }, { 0x2488, "1." }, { 0x2489, "2." },
+	{ 0x248A, "3." }, { 0x248B, "4." }, { 0x248C, "5." }, { 0x248D, "6." },
+	{ 0x248E, "7." }, { 0x248F, "8." }, { 0x2490, "9." },
+	{ 0x2491, "10." }, { 0x2492, "11." }, { 0x2493, "12." },
+	{ 0x2494, "13." }, { 0x2495, "14." }, { 0x2496, "15." },
+	{ 0x2497, "16." }, { 0x2498, "17." }, { 0x2499, "18." },
+	{ 0x249A, "19." }, { 0x249B, "20." }, { 0x249C, "(a)" },
+	{ 0x249D, "(b)" }, { 0x249E, "(c)" }, { 0x249F, "(d)" },
+	{ 0x24A0, "(e)" }, { 0x24A1, "(f)" }, { 0x24A2, "(g)" },
+	{ 0x24A3, "(h)" }, { 0x24A4, "(i)" }, { 0x24A5, "(j)" },
+	{ 0x24A6, "(k)" }, { 0x24A7, "(l)" }, { 0x24A8, "(m)" },
+	{ 0x24A9, "(n)" }, { 0x24AA, "(o)" }, { 0x24AB, "(p)" },
+	{ 0x24AC, "(q)" }, { 0x24AD, "(r)" }, { 0x24AE, "(s)" },
+	{ 0x24AF, "(t)" }, { 0x24B0, "(u)" }, { 0x24B1, "(v)" },
+	{ 0x24B2, "(w)" }, { 0x24B3, "(x)" }, { 0x24B4, "(y)" },
+	{ 0x24B5, "(z)" }, { 0x24B6, "(A)" }, { 0x24B7, "(B)" },
+	{ 0x24B8, "(C)" }, { 0x24B9, "(D)" }, { 0x24BA, "(E)" },
+	{ 0x24BB, "(F)" }, { 0x24BC, "(G)" }, { 0x24BD, "(H)" },
+	{ 0x24BE, "(I)" }, { 0x24BF, "(J)" }, { 0x24C0, "(K)" },
+	{ 0x24C1, "(L)" }, { 0x24C2, "(M)" }, { 0x24C3, "(N)" },
+	{ 0x24C4, "(O)" }, { 0x24C5, "(P)" }, { 0x24C6, "(Q)" },
+	{ 0x24C7, "(R)" }, { 0x24C8, "(S)" }, { 0x24C9, "(T)" },
+	{ 0x24CA, "(U)" }, { 0x24CB, "(V)" }, { 0x24CC, "(W)" },
+	{ 0x24CD, "(X)" }, { 0x24CE, "(Y)" }, { 0x24CF, "(Z)" },
+	{ 0x24D0, "(a)" }, { 0x24D1, "(b)" }, { 0x24D2, "(c)" },
+	{ 0x24D3, "(d)" }, { 0x24D4, "(e)" }, { 0x24D5, "(f)" },
+	{ 0x24D6, "(g)" }, { 0x24D7, "(h)" }, { 0x24D8, "(i)" },
+	{ 0x24D9, "(j)" }, { 0x24DA, "(k)" }, { 0x24DB, "(l)" },
+	{ 0x24DC, "(m)" }, { 0x24DD, "(n)" }, { 0x24DE, "(o)" },
+	{ 0x24DF, "(p)" }, { 0x24E0, "(q)" }, { 0x24E1, "(r)" },
+	{ 0x24E2, "(s)" }, { 0x24E3, "(t)" }, { 0x24E4, "(u)" },
+	{ 0x24E5, "(v)" }, { 0x24E6, "(w)" }, { 0x24E7, "(x)" },
+	{ 0x24E8, "(y)" }, { 0x24E9, "(z)" }, { 0x24EA, "(0)" },
+	{ 0x2500, "-" }, { 0x2502, "|" }, { 0x250C, "+" }, { 0x2510, "+" },
+	{ 0x2514, "+" }, { 0x2518, "+" }, { 0x251C, "+" }, { 0x2524, "+" },
+	{ 0x252C, "+" }, { 0x2534, "+" }, { 0x253C, "+" }, { 0x25CA, "<>" },
+	{ 0x25E6, "o" }, { 0x2660, "^" }, { 0x2661, "v" }, { 0x2662, "<>" },
+	{ 0x2663, "+" }, { 0x2665, "v" }, { 0x2666, "<>" }, { 0x27C2, "_|_" },
+	{ 0x2A74, "::=" }, { 0x2A75, "==" }, { 0x2A76, "===" },
+	{ 0x2AEC, "-" }, { 0x3000, " " }, { 0x30A0, "=" }, { 0x3251, "(21)" },
+	{ 0x3252, "(22)" }, { 0x3253, "(23)" }, { 0x3254, "(24)" },
+	{ 0x3255, "(25)" }, { 0x3256, "(26)" }, { 0x3257, "(27)" },
+	{ 0x3258, "(28)" }, { 0x3259, "(29)" }, { 0x325A, "(30)" },
+	{ 0x325B, "(31)" }, { 0x325C, "(32)" }, { 0x325D, "(33)" },
+	{ 0x325E, "(34)" }, { 0x325F, "(35)" }, { 0x32B1, "(36)" },
+	{ 0x32B2, "(37)" }, { 0x32B3, "(38)" }, { 0x32B4, "(39)" },
+	{ 0x32B5, "(40)" }, { 0x32B6, "(41)" }, { 0x32B7, "(42)" },
+	{ 0x32B8, "(43)" }, { 0x32B9, "(44)" }, { 0x32BA, "(45)" },
+	{ 0x32BB, "(46)" }, { 0x32BC, "(47)" }, { 0x32BD, "(48)" },
+	{ 0x32BE, "(49)" }, { 0x32BF, "(50)" }, { 0x3371, "hPa" },
+	{ 0x3372, "da" }, { 0x3373, "AU" }, { 0x3374, "bar" },
+	{ 0x3375, "oV" }, { 0x3376, "pc" }, { 0x3380, "pA" }, { 0x3381, "nA" },
+	{ 0x3382, "uA" }, { 0x3383, "mA" }, { 0x3384, "kA" }, { 0x3385, "KB" },
+	{ 0x3386, "MB" }, { 0x3387, "GB" }, { 0x3388, "cal" },
+	{ 0x3389, "kcal" }, { 0x338A, "pF" }, { 0x338B, "nF" },
+	{ 0x338C, "uF" }, { 0x338D, "ug" }, { 0x338E, "mg" }, { 0x338F, "kg" },
+	{ 0x3390, "Hz" }, { 0x3391, "kHz" }, { 0x3392, "MHz" },
+	{ 0x3393, "GHz" }, { 0x3394, "THz" }, { 0x3395, "ul" },
+	{ 0x3396, "ml" }, { 0x3397, "dl" }, { 0x3398, "kl" }, { 0x3399, "fm" },
+	{ 0x339A, "nm" }, { 0x339B, "um" }, { 0x339C, "mm" }, { 0x339D, "cm" },
+	{ 0x339E, "km" }, { 0x339F, "mm^2" }, { 0x33A0, "cm^2" },
+	{ 0x33A1, "m^2" }, { 0x33A2, "km^2" }, { 0x33A3, "mm^3" },
+	{ 0x33A4, "cm^3" }, { 0x33A5, "m^3" }, { 0x33A6, "km^3" },
+	{ 0x33A7, "m/s" }, { 0x33A8, "m/s^2" }, { 0x33A9, "Pa" },
+	{ 0x33AA, "kPa" }, { 0x33AB, "MPa" }, { 0x33AC, "GPa" },
+	{ 0x33AD, "rad" }, { 0x33AE, "rad/s" }, { 0x33AF, "rad/s^2" },
+	{ 0x33B0, "ps" }, { 0x33B1, "ns" }, { 0x33B2, "us" }, { 0x33B3, "ms" },
+	{ 0x33B4, "pV" }, { 0x33B5, "nV" }, { 0x33B6, "uV" }, { 0x33B7, "mV" },
+	{ 0x33B8, "kV" }, { 0x33B9, "MV" }, { 0x33BA, "pW" }, { 0x33BB, "nW" },
+	{ 0x33BC, "uW" }, { 0x33BD, "mW" }, { 0x33BE, "kW" }, { 0x33BF, "MW" },
+	{ 0x33C2, "a.m." }, { 0x33C3, "Bq" }, { 0x33C4, "cc" },
+	{ 0x33C5, "cd" }, { 0x33C6, "C/kg" }, { 0x33C7, "Co." },
+	{ 0x33C8, "dB" }, { 0x33C9, "Gy" }, { 0x33CA, "ha" }, { 0x33CB, "HP" },
+	{ 0x33CC, "in" }, { 0x33CD, "KK" }, { 0x33CE, "KM" }, { 0x33CF, "kt" },
+	{ 0x33D0, "lm" }, { 0x33D1, "ln" }, { 0x33D2, "log" },
+	{ 0x33D3, "lx" }, { 0x33D4, "mb" }, { 0x33D5, "mil" },
+	{ 0x33D6, "mol" }, { 0x33D7, "PH" }, { 0x33D8, "p.m." },
+	{ 0x33D9, "PPM" }, { 0x33DA, "PR" }, { 0x33DB, "sr" },
+	{ 0x33DC, "Sv" }, { 0x33DD, "Wb" }, { 0xFB00, "ff" }, { 0xFB01, "fi" },
+	{ 0xFB02, "fl" }, { 0xFB03, "ffi" }, { 0xFB04, "ffl" },
+	{ 0xFB06, "st" }, { 0xFB29, "+" }, { 0xFE00, "" }, { 0xFE01, "" },
+	{ 0xFE02, "" }, { 0xFE03, "" }, { 0xFE04, "" }, { 0xFE05, "" },
+	{ 0xFE06, "" }, { 0xFE07, "" }, { 0xFE08, "" }, { 0xFE09, "" },
+	{ 0xFE0A, "" }, { 0xFE0B, "" }, { 0xFE0C, "" }, { 0xFE0D, "" },
+	{ 0xFE0E, "" }, { 0xFE0F, "" }, { 0xFE4D, "_" }, { 0xFE4E, "_" },
+	{ 0xFE4F, "_" }, { 0xFE50, "," }, { 0xFE52, "." }, { 0xFE54, ";" },
+	{ 0xFE55, ":" }, { 0xFE57, "!" }, { 0xFE59, "(" }, { 0xFE5A, ")" },
+	{ 0xFE5B, "{" }, { 0xFE5C, "}" }, { 0xFE5F, "#" }, { 0xFE60, "&" },
+	{ 0xFE61, "*" }, { 0xFE62, "+" }, { 0xFE63, "-" }, { 0xFE64, "<" },
+	{ 0xFE65, ">" }, { 0xFE66, "=" }, { 0xFE68, "\\" }, { 0xFE69, "$" },
+	{ 0xFE6A, "%" }, { 0xFE6B, "@" }, { 0xFEFF, "" }, { 0xFF01, "!" },
+	{ 0xFF02, "\"" }, { 0xFF03, "#" }, { 0xFF04, "$" }, { 0xFF05, "%" },
+	{ 0xFF06, "&" }, { 0xFF07, "'" }, { 0xFF08, "(" }, { 0xFF09, ")" },
+	{ 0xFF0A, "*" }, { 0xFF0B, "+" }, { 0xFF0C, "," }, { 0xFF0D, "-" },
+	{ 0xFF0E, "." }, { 0xFF0F, "/" }, { 0xFF10, "0" }, { 0xFF11, "1" },
+	{ 0xFF12, "2" }, { 0xFF13, "3" }, { 0xFF14, "4" }, { 0xFF15, "5" },
+	{ 0xFF16, "6" }, { 0xFF17, "7" }, { 0xFF18, "8" }, { 0xFF19, "9" },
+	{ 0xFF1A, ":" }, { 0xFF1B, ";" }, { 0xFF1C, "<" }, { 0xFF1D, "=" },
+	{ 0xFF1E, ">" }, { 0xFF20, "@" }, { 0xFF21, "A" }, { 0xFF22, "B" },
+	{ 0xFF23, "C" }, { 0xFF24, "D" }, { 0xFF25, "E" }, { 0xFF26, "F" },
+	{ 0xFF27, "G" }, { 0xFF28, "H" }, { 0xFF29, "I" }, { 0xFF2A, "J" },
+	{ 0xFF2B, "K" }, { 0xFF2C, "L" }, { 0xFF2D, "M" }, { 0xFF2E, "N" },
+	{ 0xFF2F, "O" }, { 0xFF30, "P" }, { 0xFF31, "Q" }, { 0xFF32, "R" },
+	{ 0xFF33, "S" }, { 0xFF34, "T" }, { 0xFF35, "U" }, { 0xFF36, "V" },
+	{ 0xFF37, "W" }, { 0xFF38, "X" }, { 0xFF39, "Y" }, { 0xFF3A, "Z" },
+	{ 0xFF3B, "[" }, { 0xFF3C, "\\" }, { 0xFF3D, "]" }, { 0xFF3E, "^" },
+	{ 0xFF3F, "_" }, { 0xFF40, "`" }, { 0xFF41, "a" }, { 0xFF42, "b" },
+	{ 0xFF43, "c" }, { 0xFF44, "d" }, { 0xFF45, "e" }, { 0xFF46, "f" },
+	{ 0xFF47, "g" }, { 0xFF48, "h" }, { 0xFF49, "i" }, { 0xFF4A, "j" },
+	{ 0xFF4B, "k" }, { 0xFF4C, "l" }, { 0xFF4D, "m" }, { 0xFF4E, "n" },
+	{ 0xFF4F, "o" }, { 0xFF50, "p" }, { 0xFF51, "q" }, { 0xFF52, "r" },
+	{ 0xFF53, "s" }, { 0xFF54, "t" }, { 0xFF55, "u" }, { 0xFF56, "v" },
+	{ 0xFF57, "w" }, { 0xFF58, "x" }, { 0xFF59, "y" }, { 0xFF5A, "z" },
+	{ 0xFF5B, "{" }, { 0xFF5C, "|" }, { 0xFF5D, "}" }, { 0xFF5E, "~" },
+	{ 0x1D400, "A" }, { 0x1D401, "B" }, { 0x1D402, "C" }, { 0x1D403, "D" },
+	{ 0x1D404, "E" }, { 0x1D405, "F" }, { 0x1D406, "G" }, { 0x1D407, "H" },
+	{ 0x1D408, "I" }, { 0x1D409, "J" }, { 0x1D40A, "K" }, { 0x1D40B, "L" },
+	{ 0x1D40C, "M" }, { 0x1D40D, "N" }, { 0x1D40E, "O" }, { 0x1D40F, "P" },
+	{ 0x1D410, "Q" }, { 0x1D411, "R" }, { 0x1D412, "S" }, { 0x1D413, "T" },
+	{ 0x1D414, "U" }, { 0x1D415, "V" }, { 0x1D416, "W" }, { 0x1D417, "X" },
+	{ 0x1D418, "Y" }, { 0x1D419, "Z" }, { 0x1D41A, "a" }, { 0x1D41B, "b" },
+	{ 0x1D41C, "c" }, { 0x1D41D, "d" }, { 0x1D41E, "e" }, { 0x1D41F, "f" },
+	{ 0x1D420, "g" }, { 0x1D421, "h" }, { 0x1D422, "i" }, { 0x1D423, "j" },
+	{ 0x1D424, "k" }, { 0x1D425, "l" }, { 0x1D426, "m" }, { 0x1D427, "n" },
+	{ 0x1D428, "o" }, { 0x1D429, "p" }, { 0x1D42A, "q" }, { 0x1D42B, "r" },
+	{ 0x1D42C, "s" }, { 0x1D42D, "t" }, { 0x1D42E, "u" }, { 0x1D42F, "v" },
+	{ 0x1D430, "w" }, { 0x1D431, "x" }, { 0x1D432, "y" }, { 0x1D433, "z" },
+	{ 0x1D434, "A" }, { 0x1D435, "B" }, { 0x1D436, "C" }, { 0x1D437, "D" },
+	{ 0x1D438, "E" }, { 0x1D439, "F" }, { 0x1D43A, "G" }, { 0x1D43B, "H" },
+	{ 0x1D43C, "I" }, { 0x1D43D, "J" }, { 0x1D43E, "K" }, { 0x1D43F, "L" },
+	{ 0x1D440, "M" }, { 0x1D441, "N" }, { 0x1D442, "O" }, { 0x1D443, "P" },
+	{ 0x1D444, "Q" }, { 0x1D445, "R" }, { 0x1D446, "S" }, { 0x1D447, "T" },
+	{ 0x1D448, "U" }, { 0x1D449, "V" }, { 0x1D44A, "W" }, { 0x1D44B, "X" },
+	{ 0x1D44C, "Y" }, { 0x1D44D, "Z" }, { 0x1D44E, "a" }, { 0x1D44F, "b" },
+	{ 0x1D450, "c" }, { 0x1D451, "d" }, { 0x1D452, "e" }, { 0x1D453, "f" },
+	{ 0x1D454, "g" }, { 0x1D456, "i" }, { 0x1D457, "j" }, { 0x1D458, "k" },
+	{ 0x1D459, "l" }, { 0x1D45A, "m" }, { 0x1D45B, "n" }, { 0x1D45C, "o" },
+	{ 0x1D45D, "p" }, { 0x1D45E, "q" }, { 0x1D45F, "r" }, { 0x1D460, "s" },
+	{ 0x1D461, "t" }, { 0x1D462, "u" }, { 0x1D463, "v" }, { 0x1D464, "w" },
+	{ 0x1D465, "x" }, { 0x1D466, "y" }, { 0x1D467, "z" }, { 0x1D468, "A" },
+	{ 0x1D469, "B" }, { 0x1D46A, "C" }, { 0x1D46B, "D" }, { 0x1D46C, "E" },
+	{ 0x1D46D, "F" }, { 0x1D46E, "G" }, { 0x1D46F, "H" }, { 0x1D470, "I" },
+	{ 0x1D471, "J" }, { 0x1D472, "K" }, { 0x1D473, "L" }, { 0x1D474, "M" },
+	{ 0x1D475, "N" }, { 0x1D476, "O" }, { 0x1D477, "P" }, { 0x1D478, "Q" },
+	{ 0x1D479, "R" }, { 0x1D47A, "S" }, { 0x1D47B, "T" }, { 0x1D47C, "U" },
+	{ 0x1D47D, "V" }, { 0x1D47E, "W" }, { 0x1D47F, "X" }, { 0x1D480, "Y" },
+	{ 0x1D481, "Z" }, { 0x1D482, "a" }, { 0x1D483, "b" }, { 0x1D484, "c" },
+	{ 0x1D485, "d" }, { 0x1D486, "e" }, { 0x1D487, "f" }, { 0x1D488, "g" },
+	{ 0x1D489, "h" }, { 0x1D48A, "i" }, { 0x1D48B, "j" }, { 0x1D48C, "k" },
+	{ 0x1D48D, "l" }, { 0x1D48E, "m" }, { 0x1D48F, "n" }, { 0x1D490, "o" },
+	{ 0x1D491, "p" }, { 0x1D492, "q" }, { 0x1D493, "r" }, { 0x1D494, "s" },
+	{ 0x1D495, "t" }, { 0x1D496, "u" }, { 0x1D497, "v" }, { 0x1D498, "w" },
+	{ 0x1D499, "x" }, { 0x1D49A, "y" }, { 0x1D49B, "z" }, { 0x1D49C, "A" },
+	{ 0x1D49E, "C" }, { 0x1D49F, "D" }, { 0x1D4A2, "G" }, { 0x1D4A5, "J" },
+	{ 0x1D4A6, "K" }, { 0x1D4A9, "N" }, { 0x1D4AA, "O" }, { 0x1D4AB, "P" },
+	{ 0x1D4AC, "Q" }, { 0x1D4AE, "S" }, { 0x1D4AF, "T" }, { 0x1D4B0, "U" },
+	{ 0x1D4B1, "V" }, { 0x1D4B2, "W" }, { 0x1D4B3, "X" }, { 0x1D4B4, "Y" },
+	{ 0x1D4B5, "Z" }, { 0x1D4B6, "a" }, { 0x1D4B7, "b" }, { 0x1D4B8, "c" },
+	{ 0x1D4B9, "d" }, { 0x1D4BB, "f" }, { 0x1D4BD, "h" }, { 0x1D4BE, "i" },
+	{ 0x1D4BF, "j" }, { 0x1D4C0, "k" }, { 0x1D4C2, "m" }, { 0x1D4C3, "n" },
+	{ 0x1D4C5, "p" }, { 0x1D4C6, "q" }, { 0x1D4C7, "r" }, { 0x1D4C8, "s" },
+	{ 0x1D4C9, "t" }, { 0x1D4CA, "u" }, { 0x1D4CB, "v" }, { 0x1D4CC, "w" },
+	{ 0x1D4CD, "x" }, { 0x1D4CE, "y" }, { 0x1D4CF, "z" }, { 0x1D4D0, "A" },
+	{ 0x1D4D1, "B" }, { 0x1D4D2, "C" }, { 0x1D4D3, "D" }, { 0x1D4D4, "E" },
+	{ 0x1D4D5, "F" }, { 0x1D4D6, "G" }, { 0x1D4D7, "H" }, { 0x1D4D8, "I" },
+	{ 0x1D4D9, "J" }, { 0x1D4DA, "K" }, { 0x1D4DB, "L" }, { 0x1D4DC, "M" },
+	{ 0x1D4DD, "N" }, { 0x1D4DE, "O" }, { 0x1D4DF, "P" }, { 0x1D4E0, "Q" },
+	{ 0x1D4E1, "R" }, { 0x1D4E2, "S" }, { 0x1D4E3, "T" }, { 0x1D4E4, "U" },
+	{ 0x1D4E5, "V" }, { 0x1D4E6, "W" }, { 0x1D4E7, "X" }, { 0x1D4E8, "Y" },
+	{ 0x1D4E9, "Z" }, { 0x1D4EA, "a" }, { 0x1D4EB, "b" }, { 0x1D4EC, "c" },
+	{ 0x1D4ED, "d" }, { 0x1D4EE, "e" }, { 0x1D4EF, "f" }, { 0x1D4F0, "g" },
+	{ 0x1D4F1, "h" }, { 0x1D4F2, "i" }, { 0x1D4F3, "j" }, { 0x1D4F4, "k" },
+	{ 0x1D4F5, "l" }, { 0x1D4F6, "m" }, { 0x1D4F7, "n" }, { 0x1D4F8, "o" },
+	{ 0x1D4F9, "p" }, { 0x1D4FA, "q" }, { 0x1D4FB, "r" }, { 0x1D4FC, "s" },
+	{ 0x1D4FD, "t" }, { 0x1D4FE, "u" }, { 0x1D4FF, "v" }, { 0x1D500, "w" },
+	{ 0x1D501, "x" }, { 0x1D502, "y" }, { 0x1D503, "z" }, { 0x1D504, "A" },
+	{ 0x1D505, "B" }, { 0x1D507, "D" }, { 0x1D508, "E" }, { 0x1D509, "F" },
+	{ 0x1D50A, "G" }, { 0x1D50D, "J" }, { 0x1D50E, "K" }, { 0x1D50F, "L" },
+	{ 0x1D510, "M" }, { 0x1D511, "N" }, { 0x1D512, "O" }, { 0x1D513, "P" },
+	{ 0x1D514, "Q" }, { 0x1D516, "S" }, { 0x1D517, "T" }, { 0x1D518, "U" },
+	{ 0x1D519, "V" }, { 0x1D51A, "W" }, { 0x1D51B, "X" }, { 0x1D51C, "Y" },
+	{ 0x1D51E, "a" }, { 0x1D51F, "b" }, { 0x1D520, "c" }, { 0x1D521, "d" },
+	{ 0x1D522, "e" }, { 0x1D523, "f" }, { 0x1D524, "g" }, { 0x1D525, "h" },
+	{ 0x1D526, "i" }, { 0x1D527, "j" }, { 0x1D528, "k" }, { 0x1D529, "l" },
+	{ 0x1D52A, "m" }, { 0x1D52B, "n" }, { 0x1D52C, "o" }, { 0x1D52D, "p" },
+	{ 0x1D52E, "q" }, { 0x1D52F, "r" }, { 0x1D530, "s" }, { 0x1D531, "t" },
+	{ 0x1D532, "u" }, { 0x1D533, "v" }, { 0x1D534, "w" }, { 0x1D535, "x" },
+	{ 0x1D536, "y" }, { 0x1D537, "z" }, { 0x1D538, "A" }, { 0x1D539, "B" },
+	{ 0x1D53B, "D" }, { 0x1D53C, "E" }, { 0x1D53D, "F" }, { 0x1D53E, "G" },
+	{ 0x1D540, "I" }, { 0x1D541, "J" }, { 0x1D542, "K" }, { 0x1D543, "L" },
+	{ 0x1D544, "M" }, { 0x1D546, "O" }, { 0x1D54A, "S" }, { 0x1D54B, "T" },
+	{ 0x1D54C, "U" }, { 0x1D54D, "V" }, { 0x1D54E, "W" }, { 0x1D54F, "X" },
+	{ 0x1D550, "Y" }, { 0x1D552, "a" }, { 0x1D553, "b" }, { 0x1D554, "c" },
+	{ 0x1D555, "d" }, { 0x1D556, "e" }, { 0x1D557, "f" }, { 0x1D558, "g" },
+	{ 0x1D559, "h" }, { 0x1D55A, "i" }, { 0x1D55B, "j" }, { 0x1D55C, "k" },
+	{ 0x1D55D, "l" }, { 0x1D55E, "m" }, { 0x1D55F, "n" }, { 0x1D560, "o" },
+	{ 0x1D561, "p" }, { 0x1D562, "q" }, { 0x1D563, "r" }, { 0x1D564, "s" },
+	{ 0x1D565, "t" }, { 0x1D566, "u" }, { 0x1D567, "v" }, { 0x1D568, "w" },
+	{ 0x1D569, "x" }, { 0x1D56A, "y" }, { 0x1D56B, "z" }, { 0x1D56C, "A" },
+	{ 0x1D56D, "B" }, { 0x1D56E, "C" }, { 0x1D56F, "D" }, { 0x1D570, "E" },
+	{ 0x1D571, "F" }, { 0x1D572, "G" }, { 0x1D573, "H" }, { 0x1D574, "I" },
+	{ 0x1D575, "J" }, { 0x1D576, "K" }, { 0x1D577, "L" }, { 0x1D578, "M" },
+	{ 0x1D579, "N" }, { 0x1D57A, "O" }, { 0x1D57B, "P" }, { 0x1D57C, "Q" },
+	{ 0x1D57D, "R" }, { 0x1D57E, "S" }, { 0x1D57F, "T" }, { 0x1D580, "U" },
+	{ 0x1D581, "V" }, { 0x1D582, "W" }, { 0x1D583, "X" }, { 0x1D584, "Y" },
+	{ 0x1D585, "Z" }, { 0x1D586, "a" }, { 0x1D587, "b" }, { 0x1D588, "c" },
+	{ 0x1D589, "d" }, { 0x1D58A, "e" }, { 0x1D58B, "f" }, { 0x1D58C, "g" },
+	{ 0x1D58D, "h" }, { 0x1D58E, "i" }, { 0x1D58F, "j" }, { 0x1D590, "k" },
+	{ 0x1D591, "l" }, { 0x1D592, "m" }, { 0x1D593, "n" }, { 0x1D594, "o" },
+	{ 0x1D595, "p" }, { 0x1D596, "q" }, { 0x1D597, "r" }, { 0x1D598, "s" },
+	{ 0x1D599, "t" }, { 0x1D59A, "u" }, { 0x1D59B, "v" }, { 0x1D59C, "w" },
+	{ 0x1D59D, "x" }, { 0x1D59E, "y" }, { 0x1D59F, "z" }, { 0x1D5A0, "A" },
+	{ 0x1D5A1, "B" }, { 0x1D5A2, "C" }, { 0x1D5A3, "D" }, { 0x1D5A4, "E" },
+	{ 0x1D5A5, "F" }, { 0x1D5A6, "G" }, { 0x1D5A7, "H" }, { 0x1D5A8, "I" },
+	{ 0x1D5A9, "J" }, { 0x1D5AA, "K" }, { 0x1D5AB, "L" }, { 0x1D5AC, "M" },
+	{ 0x1D5AD, "N" }, { 0x1D5AE, "O" }, { 0x1D5AF, "P" }, { 0x1D5B0, "Q" },
+	{ 0x1D5B1, "R" }, { 0x1D5B2, "S" }, { 0x1D5B3, "T" }, { 0x1D5B4, "U" },
+	{ 0x1D5B5, "V" }, { 0x1D5B6, "W" }, { 0x1D5B7, "X" }, { 0x1D5B8, "Y" },
+	{ 0x1D5B9, "Z" }, { 0x1D5BA, "a" }, { 0x1D5BB, "b" }, { 0x1D5BC, "c" },
+	{ 0x1D5BD, "d" }, { 0x1D5BE, "e" }, { 0x1D5BF, "f" }, { 0x1D5C0, "g" },
+	{ 0x1D5C1, "h" }, { 0x1D5C2, "i" }, { 0x1D5C3, "j" }, { 0x1D5C4, "k" },
+	{ 0x1D5C5, "l" }, { 0x1D5C6, "m" }, { 0x1D5C7, "n" }, { 0x1D5C8, "o" },
+	{ 0x1D5C9, "p" }, { 0x1D5CA, "q" }, { 0x1D5CB, "r" }, { 0x1D5CC, "s" },
+	{ 0x1D5CD, "t" }, { 0x1D5CE, "u" }, { 0x1D5CF, "v" }, { 0x1D5D0, "w" },
+	{ 0x1D5D1, "x" }, { 0x1D5D2, "y" }, { 0x1D5D3, "z" }, { 0x1D5D4, "A" },
+	{ 0x1D5D5, "B" }, { 0x1D5D6, "C" }, { 0x1D5D7, "D" }, { 0x1D5D8, "E" },
+	{ 0x1D5D9, "F" }, { 0x1D5DA, "G" }, { 0x1D5DB, "H" }, { 0x1D5DC, "I" },
+	{ 0x1D5DD, "J" }, { 0x1D5DE, "K" }, { 0x1D5DF, "L" }, { 0x1D5E0, "M" },
+	{ 0x1D5E1, "N" }, { 0x1D5E2, "O" }, { 0x1D5E3, "P" }, { 0x1D5E4, "Q" },
+	{ 0x1D5E5, "R" }, { 0x1D5E6, "S" }, { 0x1D5E7, "T" }, { 0x1D5E8, "U" },
+	{ 0x1D5E9, "V" }, { 0x1D5EA, "W" }, { 0x1D5EB, "X" }, { 0x1D5EC, "Y" },
+	{ 0x1D5ED, "Z" }, { 0x1D5EE, "a" }, { 0x1D5EF, "b" }, { 0x1D5F0, "c" },
+	{ 0x1D5F1, "d" }, { 0x1D5F2, "e" }, { 0x1D5F3, "f" }, { 0x1D5F4, "g" },
+	{ 0x1D5F5, "h" }, { 0x1D5F6, "i" }, { 0x1D5F7, "j" }, { 0x1D5F8, "k" },
+	{ 0x1D5F9, "l" }, { 0x1D5FA, "m" }, { 0x1D5FB, "n" }, { 0x1D5FC, "o" },
+	{ 0x1D5FD, "p" }, { 0x1D5FE, "q" }, { 0x1D5FF, "r" }, { 0x1D600, "s" },
+	{ 0x1D601, "t" }, { 0x1D602, "u" }, { 0x1D603, "v" }, { 0x1D604, "w" },
+	{ 0x1D605, "x" }, { 0x1D606, "y" }, { 0x1D607, "z" }, { 0x1D608, "A" },
+	{ 0x1D609, "B" }, { 0x1D60A, "C" }, { 0x1D60B, "D" }, { 0x1D60C, "E" },
+	{ 0x1D60D, "F" }, { 0x1D60E, "G" }, { 0x1D60F, "H" }, { 0x1D610, "I" },
+	{ 0x1D611, "J" }, { 0x1D612, "K" }, { 0x1D613, "L" }, { 0x1D614, "M" },
+	{ 0x1D615, "N" }, { 0x1D616, "O" }, { 0x1D617, "P" }, { 0x1D618, "Q" },
+	{ 0x1D619, "R" }, { 0x1D61A, "S" }, { 0x1D61B, "T" }, { 0x1D61C, "U" },
+	{ 0x1D61D, "V" }, { 0x1D61E, "W" }, { 0x1D61F, "X" }, { 0x1D620, "Y" },
+	{ 0x1D621, "Z" }, { 0x1D622, "a" }, { 0x1D623, "b" }, { 0x1D624, "c" },
+	{ 0x1D625, "d" }, { 0x1D626, "e" }, { 0x1D627, "f" }, { 0x1D628, "g" },
+	{ 0x1D629, "h" }, { 0x1D62A, "i" }, { 0x1D62B, "j" }, { 0x1D62C, "k" },
+	{ 0x1D62D, "l" }, { 0x1D62E, "m" }, { 0x1D62F, "n" }, { 0x1D630, "o" },
+	{ 0x1D631, "p" }, { 0x1D632, "q" }, { 0x1D633, "r" }, { 0x1D634, "s" },
+	{ 0x1D635, "t" }, { 0x1D636, "u" }, { 0x1D637, "v" }, { 0x1D638, "w" },
+	{ 0x1D639, "x" }, { 0x1D63A, "y" }, { 0x1D63B, "z" }, { 0x1D63C, "A" },
+	{ 0x1D63D, "B" }, { 0x1D63E, "C" }, { 0x1D63F, "D" }, { 0x1D640, "E" },
+	{ 0x1D641, "F" }, { 0x1D642, "G" }, { 0x1D643, "H" }, { 0x1D644, "I" },
+	{ 0x1D645, "J" }, { 0x1D646, "K" }, { 0x1D647, "L" }, { 0x1D648, "M" },
+	{ 0x1D649, "N" }, { 0x1D64A, "O" }, { 0x1D64B, "P" }, { 0x1D64C, "Q" },
+	{ 0x1D64D, "R" }, { 0x1D64E, "S" }, { 0x1D64F, "T" }, { 0x1D650, "U" },
+	{ 0x1D651, "V" }, { 0x1D652, "W" }, { 0x1D653, "X" }, { 0x1D654, "Y" },
+	{ 0x1D655, "Z" }, { 0x1D656, "a" }, { 0x1D657, "b" }, { 0x1D658, "c" },
+	{ 0x1D659, "d" }, { 0x1D65A, "e" }, { 0x1D65B, "f" }, { 0x1D65C, "g" },
+	{ 0x1D65D, "h" }, { 0x1D65E, "i" }, { 0x1D65F, "j" }, { 0x1D660, "k" },
+	{ 0x1D661, "l" }, { 0x1D662, "m" }, { 0x1D663, "n" }, { 0x1D664, "o" },
+	{ 0x1D665, "p" }, { 0x1D666, "q" }, { 0x1D667, "r" }, { 0x1D668, "s" },
+	{ 0x1D669, "t" }, { 0x1D66A, "u" }, { 0x1D66B, "v" }, { 0x1D66C, "w" },
+	{ 0x1D66D, "x" }, { 0x1D66E, "y" }, { 0x1D66F, "z" }, { 0x1D670, "A" },
+	{ 0x1D671, "B" }, { 0x1D672, "C" }, { 0x1D673, "D" }, { 0x1D674, "E" },
+	{ 0x1D675, "F" }, { 0x1D676, "G" }, { 0x1D677, "H" }, { 0x1D678, "I" },
+	{ 0x1D679, "J" }, { 0x1D67A, "K" }, { 0x1D67B, "L" }, { 0x1D67C, "M" },
+	{ 0x1D67D, "N" }, { 0x1D67E, "O" }, { 0x1D67F, "P" }, { 0x1D680, "Q" },
+	{ 0x1D681, "R" }, { 0x1D682, "S" }, { 0x1D683, "T" }, { 0x1D684, "U" },
+	{ 0x1D685, "V" }, { 0x1D686, "W" }, { 0x1D687, "X" }, { 0x1D688, "Y" },
+	{ 0x1D689, "Z" }, { 0x1D68A, "a" }, { 0x1D68B, "b" }, { 0x1D68C, "c" },
+	{ 0x1D68D, "d" }, { 0x1D68E, "e" }, { 0x1D68F, "f" }, { 0x1D690, "g" },
+	{ 0x1D691, "h" }, { 0x1D692, "i" }, { 0x1D693, "j" }, { 0x1D694, "k" },
+	{ 0x1D695, "l" }, { 0x1D696, "m" }, { 0x1D697, "n" }, { 0x1D698, "o" },
+	{ 0x1D699, "p" }, { 0x1D69A, "q" }, { 0x1D69B, "r" }, { 0x1D69C, "s" },
+	{ 0x1D69D, "t" }, { 0x1D69E, "u" }, { 0x1D69F, "v" }, { 0x1D6A0, "w" },
+	{ 0x1D6A1, "x" }, { 0x1D6A2, "y" }, { 0x1D6A3, "z" }, { 0x1D7CE, "0" },
+	{ 0x1D7CF, "1" }, { 0x1D7D0, "2" }, { 0x1D7D1, "3" }, { 0x1D7D2, "4" },
+	{ 0x1D7D3, "5" }, { 0x1D7D4, "6" }, { 0x1D7D5, "7" }, { 0x1D7D6, "8" },
+	{ 0x1D7D7, "9" }, { 0x1D7D8, "0" }, { 0x1D7D9, "1" }, { 0x1D7DA, "2" },
+	{ 0x1D7DB, "3" }, { 0x1D7DC, "4" }, { 0x1D7DD, "5" }, { 0x1D7DE, "6" },
+	{ 0x1D7DF, "7" }, { 0x1D7E0, "8" }, { 0x1D7E1, "9" }, { 0x1D7E2, "0" },
+	{ 0x1D7E3, "1" }, { 0x1D7E4, "2" }, { 0x1D7E5, "3" }, { 0x1D7E6, "4" },
+	{ 0x1D7E7, "5" }, { 0x1D7E8, "6" }, { 0x1D7E9, "7" }, { 0x1D7EA, "8" },
+	{ 0x1D7EB, "9" }, { 0x1D7EC, "0" }, { 0x1D7ED, "1" }, { 0x1D7EE, "2" },
+	{ 0x1D7EF, "3" }, { 0x1D7F0, "4" }, { 0x1D7F1, "5" }, { 0x1D7F2, "6" },
+	{ 0x1D7F3, "7" }, { 0x1D7F4, "8" }, { 0x1D7F5, "9" }, { 0x1D7F6, "0" },
+	{ 0x1D7F7, "1" }, { 0x1D7F8, "2" }, { 0x1D7F9, "3" }, { 0x1D7FA, "4" },
+	{ 0x1D7FB, "5" }, { 0x1D7FC, "6" }, { 0x1D7FD, "7" }, { 0x1D7FE, "8" },
+	{ 0x1D7FF, "9" }, { 0xE0000, "" }, { 0xE0001, "" }, { 0xE0002, "" },
+	{ 0xE0003, "" }, { 0xE0004, "" }, { 0xE0005, "" }, { 0xE0006, "" },
+	{ 0xE0007, "" }, { 0xE0008, "" }, { 0xE0009, "" }, { 0xE000A, "" },
+	{ 0xE000B, "" }, { 0xE000C, "" }, { 0xE000D, "" }, { 0xE000E, "" },
+	{ 0xE000F, "" }, { 0xE0010, "" }, { 0xE0011, "" }, { 0xE0012, "" },
+	{ 0xE0013, "" }, { 0xE0014, "" }, { 0xE0015, "" }, { 0xE0016, "" },
+	{ 0xE0017, "" }, { 0xE0018, "" }, { 0xE0019, "" }, { 0xE001A, "" },
+	{ 0xE001B, "" }, { 0xE001C, "" }, { 0xE001D, "" }, { 0xE001E, "" },
+	{ 0xE001F, "" }, { 0xE0020, "" }, { 0xE0021, "" }, { 0xE0022, "" },
+	{ 0xE0023, "" }, { 0xE0024, "" }, { 0xE0025, "" }, { 0xE0026, "" },
+	{ 0xE0027, "" }, { 0xE0028, "" }, { 0xE0029, "" }, { 0xE002A, "" },
+	{ 0xE002B, "" }, { 0xE002C, "" }, { 0xE002D, "" }, { 0xE002E, "" },
+	{ 0xE002F, "" }, { 0xE0030, "" }, { 0xE0031, "" }, { 0xE0032, "" },
+	{ 0xE0033, "" }, { 0xE0034, "" }, { 0xE0035, "" }, { 0xE0036, "" },
+	{ 0xE0037, "" }, { 0xE0038, "" }, { 0xE0039, "" }, { 0xE003A, "" },
+	{ 0xE003B, "" }, { 0xE003C, "" }, { 0xE003D, "" }, { 0xE003E, "" },
+	{ 0xE003F, "" }, { 0xE0040, "" }, { 0xE0041, "" }, { 0xE0042, "" },
+	{ 0xE0043, "" }, { 0xE0044, "" }, { 0xE0045, "" }, { 0xE0046, "" },
+	{ 0xE0047, "" }, { 0xE0048, "" }, { 0xE0049, "" }, { 0xE004A, "" },
+	{ 0xE004B, "" }, { 0xE004C, "" }, { 0xE004D, "" }, { 0xE004E, "" },
+	{ 0xE004F, "" }, { 0xE0050, "" }, { 0xE0051, "" }, { 0xE0052, "" },
+	{ 0xE0053, "" }, { 0xE0054, "" }, { 0xE0055, "" }, { 0xE0056, "" },
+	{ 0xE0057, "" }, { 0xE0058, "" }, { 0xE0059, "" }, { 0xE005A, "" },
+	{ 0xE005B, "" }, { 0xE005C, "" }, { 0xE005D, "" }, { 0xE005E, "" },
+	{ 0xE005F, "" }, { 0xE0060, "" }, { 0xE0061, "" }, { 0xE0062, "" },
+	{ 0xE0063, "" }, { 0xE0064, "" }, { 0xE0065, "" }, { 0xE0066, "" },
+	{ 0xE0067, "" }, { 0xE0068, "" }, { 0xE0069, "" }, { 0xE006A, "" },
+	{ 0xE006B, "" }, { 0xE006C, "" }, { 0xE006D, "" }, { 0xE006E, "" },
+	{ 0xE006F, "" }, { 0xE0070, "" }, { 0xE0071, "" }, { 0xE0072, "" },
+	{ 0xE0073, "" }, { 0xE0074, "" }, { 0xE0075, "" }, { 0xE0076, "" },
+	{ 0xE0077, "" }, { 0xE0078, "" }, { 0xE0079, "" }, { 0xE007A, "" },
+	{ 0xE007B, "" }, { 0xE007C, "" }, { 0xE007D, "" }, { 0xE007E, "" },
+	{ 0xE007F, "" },
+};
+
+static int
+translit_cmp(const void *key, const void *elem)
+{
+	unsigned int u = *(const unsigned int *)key;
+	unsigned int e = ((const struct translit *)elem)->unicode;
+
+	return u < e ? -1 : u > e ? 1 : 0;
+}
+
+/* the index in translits[] of u, or -1 */
+static constexpr int
+translit_find(unsigned int u, size_t lo = 0, size_t hi = nelems(translits))
+{
+	return lo == hi ? -1 :
+		translits[(lo + hi) / 2].unicode == u ? (int)((lo + hi) / 2) :
+		translits[(lo + hi) / 2].unicode < u ?
+			translit_find(u, (lo + hi) / 2 + 1, hi) :
+			translit_find(u, lo, (lo + hi) / 2);
+}
+
+/*
+ * The blocks most text outside ASCII comes from are looked up directly
+ * in an index generated at compile time, the rest is searched for.
+ */
+template<unsigned int Base, unsigned int... U> struct TranslitBlock {
+	static constexpr short index[sizeof...(U)] = {
+		(short)translit_find(Base + U)...
+	};
+};
+template<unsigned int Base, unsigned int... U>
+constexpr short TranslitBlock<Base, U...>::index[sizeof...(U)];
+
+template<unsigned int Base, unsigned int N, unsigned int... U>
+struct MakeTranslitBlock : MakeTranslitBlock<Base, N - 1, N - 1, U...> {};
+template<unsigned int Base, unsigned int... U>
+struct MakeTranslitBlock<Base, 0, U...> : TranslitBlock<Base, U...> {};
+
+/* Latin-1 Supplement up to Spacing Modifier Letters */
+typedef MakeTranslitBlock<0x0080, 0x0280> translit_latin;
+/* General Punctuation, super- and subscripts, currency symbols */
+typedef MakeTranslitBlock<0x2000, 0x00D0> translit_punct;
+
+static const struct translit *
+translit_lookup(unsigned int u)
+{
+	int i;
+
+	if (u - 0x0080 < nelems(translit_latin::index))
+		i = translit_latin::index[u - 0x0080];
+	else if (u - 0x2000 < nelems(translit_punct::index))
+		i = translit_punct::index[u - 0x2000];
+	else
+		return (const struct translit *)bsearch(&u, translits,
+				nelems(translits), sizeof(translits[0]), translit_cmp);
+	return i < 0 ? NULL : &translits[i];
+}
+
+bool
+charset_is_ascii_translit(const char *name)
+{
+	char norm[32];
+	const char *suffix = charset_normalize(name, norm, sizeof(norm));
+
+	return strcasecmp(suffix, "//TRANSLIT") == 0 &&
+		(strcmp(norm, "ASCII") == 0 || strcmp(norm, "USASCII") == 0);
+}
+
+size_t
+charset_translit_ascii(const unsigned char *inp, size_t len, bool final,
+		unsigned char *out, size_t *used)
+{
+	const unsigned char *end = inp + len;
+	const unsigned char *start = inp;
+	unsigned char *o = out;
+
+	while (inp < end) {
+		bool truncated;
+		const unsigned char *vend = inp + utf8_validate(inp, end - inp,
+				&truncated);
+
+		while (inp < vend) {
+			const struct translit *t;
+			unsigned int u;
+
+			/* copy ASCII runs 8 bytes at a time */
+			while (vend - inp >= 8) {
+				uint64_t w;
+
+				memcpy(&w, inp, sizeof(w));
+				if (w & 0x8080808080808080ULL)
+					break;
+				memcpy(o, &w, sizeof(w));
+				inp += 8;
+				o += 8;
+			}
+			if (inp == vend)
+				break;
+
+			if (*inp < 0x80) {
+				*o++ = *inp++;
+				continue;
+			}
+
+			/* validated already, so just decode */
+			if (*inp < 0xE0) {
+				u = (inp[0] & 0x1F) << 6 | (inp[1] & 0x3F);
+				inp += 2;
+			} else if (*inp < 0xF0) {
+				u = (inp[0] & 0x0F) << 12 | (inp[1] & 0x3F) << 6 |
+					(inp[2] & 0x3F);
+				inp += 3;
+			} else {
+				u = (inp[0] & 0x07) << 18 | (inp[1] & 0x3F) << 12 |
+					(inp[2] & 0x3F) << 6 | (inp[3] & 0x3F);
+				inp += 4;
+			}
+
+			t = translit_lookup(u);
+			if (t == NULL) {
+				*o++ = '?';
+			} else {
+				const char *a;
+
+				for (a = t->ascii; *a != '\0'; a++)
+					*o++ = *a;
+			}
+		}
+
+		if (inp == end || (truncated && !final))
+			break;
+		/* invalid byte, or the truncated end of the output */
+		*o++ = '?';
+		inp++;
+	}
+
+	*used = inp - start;
+	return o - out;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#ifndef CHARSETS_H
+#define CHARSETS_H 1
+
+#include <stddef.h>
+
+/*
+ * Built-in decoders for the common single-byte charsets, and an encoder
+ * for transliterated ASCII, these are a lot faster than going through
+ * iconv.
+ */
+struct charset;
+
+/*
+ * Look up a decoder by any of the usual names for it (e.g.
+ * "ISO-8859-1", "latin1", "cp1252"), returns NULL if there is none, in
+ * which case iconv should be used.
+ */
+extern const struct charset *charset_find(const char *name);
+
+/*
+ * Decode "len" bytes from "inp" into UTF-8 at "out", which must have
+ * room for 3 * "len" + 1 bytes.  Bytes that have no mapping in the
+ * charset are replaced with a '?', like our iconv error handling does,
+ * and counted in "*replaced".  Returns the number of bytes written to
+ * "out".
+ */
+extern size_t charset_decode(const struct charset *cs,
+		const unsigned char *inp, size_t len, unsigned char *out,
+		size_t *replaced);
+
+/*
+ * Look for a charset declared in a <meta> tag in the first "len" bytes
+ * of a document, the way browsers do.  When found, it is copied into
+ * "name" and true is returned.
+ */
+extern bool charset_prescan(const unsigned char *buf, size_t len,
+		char *name, size_t namesze);
+
+/*
+ * Returns whether "name" asks for ASCII with transliteration, e.g.
+ * "ASCII//TRANSLIT", which charset_translit_ascii() can do.
+ */
+extern bool charset_is_ascii_translit(const char *name);
+
+/*
+ * Convert the UTF-8 in "inp" to ASCII at "out", which must have room
+ * for 4 * "len" bytes.  Characters outside ASCII are replaced by an
+ * approximation, or a '?' when there is none.  Unless "final" is set,
+ * an incomplete UTF-8 sequence at the end of "inp" is not converted.
+ * "*used" is set to the number of bytes consumed from "inp", the
+ * number of bytes written to "out" is returned.
+ */
+extern size_t charset_translit_ascii(const unsigned char *inp, size_t len,
+		bool final, unsigned char *out, size_t *used);
+
+#endif
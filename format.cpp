@@ -93,7 +93,7 @@ struct ListFormat {
 	Area::size_type get_indent(int nesting) const;
 	const string    &get_default_type(int nesting) const;
 	int             get_type(
-		const list<TagAttribute> *attributes,
+		const TagAttributes *attributes,
 		int nesting,
 		int default_default_type
 		) const;
@@ -333,7 +333,7 @@ ListNormalItem::format(
 
 	if (number_in_out) {
 		number = *number_in_out = get_attribute(
-				attributes.get(), "VALUE", *number_in_out
+				attributes.get(), ATTR_VALUE, *number_in_out
 				);
 	}
 
@@ -561,7 +561,7 @@ Area *
 Heading::format(Area::size_type w, int halign) const
 {
 	halign = get_attribute(
-			attributes.get(), "ALIGN", halign,
+			attributes.get(), ATTR_ALIGN, halign,
 			"LEFT", Area::LEFT,
 			"CENTER", Area::CENTER,
 			"RIGHT", Area::RIGHT,
@@ -654,7 +654,7 @@ Heading::format(Area::size_type w, int halign) const
 Area *
 Preformatted::format(Area::size_type w, int halign) const
 {
-	w = get_attribute(attributes.get(), "WIDTH", w);
+	w = get_attribute(attributes.get(), ATTR_WIDTH, w);
 
 	static BlockFormat bf("PRE");
 
@@ -692,7 +692,7 @@ Paragraph::format(Area::size_type w, int halign) const
 		return 0;
 
 	halign = get_attribute(
-			attributes.get(), "ALIGN", halign,
+			attributes.get(), ATTR_ALIGN, halign,
 			"LEFT", Area::LEFT,
 			"CENTER", Area::CENTER,
 			"RIGHT", Area::RIGHT,
@@ -732,7 +732,7 @@ Image::line_format() const
 
 	{
 		bool ex;
-		istr alt(get_attribute(attributes.get(), "ALT", &ex));
+		istr alt(get_attribute(attributes.get(), ATTR_ALT, &ex));
 		if (ex) {
 			if (!alt.empty()) {
 				replace_sgml_entities(&alt);
@@ -750,7 +750,7 @@ Image::line_format() const
 	}
 
 	{
-		istr src(get_attribute(attributes.get(), "SRC", ""));
+		istr src(get_attribute(attributes.get(), ATTR_SRC, ""));
 		if (!src.empty())
 			return new Line((src >>= '[') <<= ']');
 	}
@@ -765,7 +765,7 @@ Applet::format(Area::size_type w, int /*halign*/) const
 {
 	if (content.get()) {
 		int halign = get_attribute(
-				attributes.get(), "ALIGN", Area::CENTER,
+				attributes.get(), ATTR_ALIGN, Area::CENTER,
 				"LEFT", Area::LEFT,
 				"MIDDLE", Area::CENTER,
 				"RIGHT", Area::RIGHT,
@@ -777,13 +777,13 @@ Applet::format(Area::size_type w, int /*halign*/) const
 	}
 
 	{
-		istr alt(get_attribute(attributes.get(), "ALT", ""));
+		istr alt(get_attribute(attributes.get(), ATTR_ALT, ""));
 		if (!alt.empty())
 			return new Area((alt >>= "[Java Applet: ") <<= ']');
 	}
 
 	{
-		istr code(get_attribute(attributes.get(), "CODE", ""));
+		istr code(get_attribute(attributes.get(), ATTR_CODE, ""));
 		if (!code.empty())
 			return new Area((code >>= "[Java Applet ") <<= ']');
 	}
@@ -801,13 +801,13 @@ Applet::line_format() const
 	}
 
 	{
-		istr alt(get_attribute(attributes.get(), "ALT", ""));
+		istr alt(get_attribute(attributes.get(), ATTR_ALT, ""));
 		if (!alt.empty())
 			return new Line((alt >>= "[Java Applet: ") <<= ']');
 	}
 
 	{
-		istr code(get_attribute(attributes.get(), "CODE", ""));
+		istr code(get_attribute(attributes.get(), ATTR_CODE, ""));
 		if (!code.empty())
 			return new Line((code >>= "[Java Applet ") <<= ']');
 	}
@@ -821,7 +821,7 @@ Area *
 Division::format(Area::size_type w, int halign) const
 {
 	return ::format(body_content.get(), w, get_attribute(
-			attributes.get(), "ALIGN", halign,
+			attributes.get(), ATTR_ALIGN, halign,
 			"LEFT", Area::LEFT,
 			"CENTER", Area::CENTER,
 			"RIGHT", Area::RIGHT,
@@ -887,12 +887,12 @@ Form::format(Area::size_type w, int halign) const
 Line *
 Input::line_format() const
 {
-	string type = get_attribute(attributes.get(), "TYPE", "TEXT").c_str();
-	string name = get_attribute(attributes.get(), "NAME", "").c_str();
-	string value = get_attribute(attributes.get(), "VALUE", "").c_str();
-	bool checked = get_attribute(attributes.get(), "CHECKED", "0") != "0";
-	int size = get_attribute(attributes.get(), "SIZE", -1);
-	string src = get_attribute(attributes.get(), "SRC", "").c_str();
+	string type = get_attribute(attributes.get(), ATTR_TYPE, "TEXT").c_str();
+	string name = get_attribute(attributes.get(), ATTR_NAME, "").c_str();
+	string value = get_attribute(attributes.get(), ATTR_VALUE, "").c_str();
+	bool checked = get_attribute(attributes.get(), ATTR_CHECKED, "0") != "0";
+	int size = get_attribute(attributes.get(), ATTR_SIZE, -1);
+	string src = get_attribute(attributes.get(), ATTR_SRC, "").c_str();
 
 	string res;
 	if (cmp_nocase(type, "TEXT") == 0) {
@@ -935,7 +935,7 @@ Select::line_format() const
 	if (!content.get() || content->empty())
 		return new Line("[Empty selection]");
 
-	bool multiple = get_attribute(attributes.get(), "MULTIPLE", "0") != "0";
+	bool multiple = get_attribute(attributes.get(), ATTR_MULTIPLE, "0") != "0";
 
 	auto_ptr<Line> res(new Line(multiple ? "[One or more of " : "[One of: "));
 	const list<auto_ptr<Option> > &c(*content);
@@ -964,6 +964,10 @@ TextArea::format(Area::size_type w, int halign) const
 Line *
 PCData::line_format() const
 {
+	if (view != NULL) {
+		istr s;
+		return new Line(s.append(view, viewlen));
+	}
 	return new Line(text);
 }
 
@@ -1155,7 +1159,7 @@ Anchor::line_format() const
 	if (!res.get())
 		return 0;
 
-	istr href(get_attribute(attributes.get(), "HREF", ""));
+	istr href(get_attribute(attributes.get(), ATTR_HREF, ""));
 	if (!href.empty()) {
 		res->add_attribute(get_link_cell_attributes(href));
 		if (refnum > 0) {
@@ -1174,7 +1178,7 @@ Anchor::format(Area::size_type w, int halign) const
 	if (!res.get())
 		return 0;
 
-	istr href(get_attribute(attributes.get(), "HREF", ""));
+	istr href(get_attribute(attributes.get(), ATTR_HREF, ""));
 	if (!href.empty()) {
 		res->add_attribute(get_link_cell_attributes(href));
 		if (refnum > 0) {
@@ -1676,7 +1680,7 @@ ListFormat::get_indent(int nesting) const
 
 int
 ListFormat::get_type(
-	const list<TagAttribute> *attributes,
+	const TagAttributes *attributes,
 	int nesting,
 	int default_default_type
 	) const
@@ -1689,7 +1693,7 @@ ListFormat::get_type(
 		);
 
 	return get_attribute(
-			attributes, "TYPE",
+			attributes, ATTR_TYPE,
 			default_type, // dflt1
 			default_default_type, // dflt2, if dflt1 fails
 			"NO_BULLET", NO_BULLET,
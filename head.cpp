@@ -0,0 +1,141 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#include <string.h>
+#include <ctype.h>
+
+#include "head.h"
+#include "sax.h"
+#include "cmp_nocase.h"
+#include "sgml.h"
+
+static bool
+name_is(const char *name, size_t len, const char *want)
+{
+	return _cmp_nocase(name, len, want, strlen(want)) == 0;
+}
+
+/*
+ * Collects the title and base URL, and stops where the HEAD ends,
+ * which is at </HEAD>, <BODY>, or else the first text outside of the
+ * TITLE, SCRIPT or STYLE.
+ */
+class HeadHandler : public SaxHandler {
+	public:
+		HeadHandler():
+			have_title(false),
+			have_base(false),
+			in_title(false),
+			in_cdata(false)
+		{
+		}
+
+		void start_tag(const char *name, size_t namelen,
+				const SaxAttribute *attrs, size_t nattrs)
+		{
+			if (name_is(name, namelen, "BODY")) {
+				stop = true;
+			} else if (name_is(name, namelen, "TITLE")) {
+				/* only the first one counts */
+				in_title = !have_title;
+				have_title = true;
+			} else if (name_is(name, namelen, "BASE")) {
+				for (size_t i = 0; i < nattrs && !have_base; i++) {
+					if (name_is(attrs[i].name, attrs[i].namelen, "HREF")) {
+						istr href;
+
+						/* values come with their entities */
+						href.append((const unsigned char *)attrs[i].value,
+								attrs[i].valuelen);
+						replace_sgml_entities(&href);
+						base = href.c_str();
+						have_base = true;
+					}
+				}
+			} else if (name_is(name, namelen, "SCRIPT") ||
+					name_is(name, namelen, "STYLE"))
+			{
+				in_cdata = true;
+			}
+		}
+		void end_tag(const char *name, size_t namelen)
+		{
+			/* markup in the title is taken for its text */
+			if (name_is(name, namelen, "TITLE"))
+				in_title = false;
+			else if (name_is(name, namelen, "SCRIPT") ||
+					name_is(name, namelen, "STYLE"))
+				in_cdata = false;
+			else if (name_is(name, namelen, "HEAD"))
+				stop = true;
+		}
+		void text(const char *text, size_t len)
+		{
+			size_t i;
+
+			if (in_title) {
+				title.append(text, len);
+				return;
+			}
+			if (in_cdata)
+				return;
+			for (i = 0; i < len && isspace((unsigned char)text[i]); i++)
+				;
+			if (i < len)
+				stop = true;
+		}
+
+		string title;
+		bool have_title;
+		string base;
+		bool have_base;
+
+	private:
+		bool in_title;
+		bool in_cdata;
+};
+
+/*
+ * Print the title, base URL and charset of the document, from no more
+ * of it than its HEAD.
+ */
+void
+print_head(HTMLControl &control, iconvstream &os)
+{
+	HeadHandler head;
+	const char *encoding;
+	string title;
+	bool space = false;
+
+	control.parse_events(&head);
+
+	/* the title is on one line, like it would be rendered */
+	for (const char c : head.title) {
+		if (isspace((unsigned char)c)) {
+			space = !title.empty();
+			continue;
+		}
+		if (space)
+			title += ' ';
+		title += c;
+		space = false;
+	}
+	if (!title.empty())
+		os << "Title: " << title << endl;
+	if (head.have_base)
+		os << "Base: " << head.base << endl;
+	encoding = os.input_encoding();
+	if (strcmp(encoding, "auto") != 0)
+		os << "Charset: " << encoding << endl;
+}
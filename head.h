@@ -0,0 +1,23 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#ifndef HEAD_H
+#define HEAD_H 1
+
+#include "HTMLControl.h"
+#include "iconvstream.h"
+
+void print_head(HTMLControl &control, iconvstream &os);
+
+#endif
@@ -35,99 +35,81 @@ Element::~Element()
 
 istr
 get_attribute(
-	const list<TagAttribute> *as,
-	const char               *name,
+	const TagAttributes      *as,
+	AttributeName            name,
 	const char               *dflt
 	)
 {
-	if (as) {
-		list<TagAttribute>::const_iterator i;
-		for (i = as->begin(); i != as->end(); ++i) {
-			if (cmp_nocase((*i).first, name) == 0)
-				return (*i).second;
-		}
-	}
-	return istr(dflt);
+	int i = as ? as->find(name) : -1;
+
+	return i < 0 ? istr(dflt) : as->value(i);
 }
 
 // *exists is set to false if attribute *name does not exist - Johannes Geiger
 istr
 get_attribute(
-	const list<TagAttribute> *as,
-	const char               *name,
+	const TagAttributes      *as,
+	AttributeName            name,
 	bool                     *exists
 	)
 {
-	*exists = true;
-	if (as) {
-		list<TagAttribute>::const_iterator i;
-		for (i = as->begin(); i != as->end(); ++i) {
-			if (cmp_nocase((*i).first, name) == 0)
-				return (*i).second;
-		}
-	}
-	*exists = false;
-	return istr("");
+	int i = as ? as->find(name) : -1;
+
+	*exists = i >= 0;
+	return i < 0 ? istr("") : as->value(i);
 }
 
 int
 get_attribute(
-	const list<TagAttribute> *as,
-	const char               *name,
+	const TagAttributes      *as,
+	AttributeName            name,
 	int dflt
 	)
 {
-	if (as) {
-		list<TagAttribute>::const_iterator i;
-		for (i = as->begin(); i != as->end(); ++i) {
-			if (cmp_nocase((*i).first, name) == 0)
-				return atoi((*i).second.c_str());
-		}
-	}
-	return dflt;
+	int i = as ? as->find(name) : -1;
+
+	return i < 0 ? dflt : atoi(as->raw_value(i).c_str());
 }
 
 int
 get_attribute(
-	const list<TagAttribute> *as,
-	const char               *name,
+	const TagAttributes      *as,
+	AttributeName            name,
 	int dflt,
 	const char               *s1,
 	int v1,
 	...
 	)
 {
-	if (as) {
-		list<TagAttribute>::const_iterator i;
-		for (i = as->begin(); i != as->end(); ++i) {
-			if (cmp_nocase((*i).first, name) == 0) {
-				const char *s = s1;
-				int v = v1;
-
-				va_list va;
-				va_start(va, v1);
-				for (;;) {
-					if (cmp_nocase(s, (*i).second.c_str()) == 0)
-						break;
-					s = va_arg(va, const char *);
-					if (!s) {
-						v = dflt;
-						break;
-					}
-					v = va_arg(va, int);
-				}
-				va_end(va);
-				return v;
+	int i = as ? as->find(name) : -1;
+
+	if (i >= 0) {
+		string val = as->raw_value(i);
+		const char *s = s1;
+		int v = v1;
+
+		va_list va;
+		va_start(va, v1);
+		for (;;) {
+			if (cmp_nocase(s, val.c_str()) == 0)
+				break;
+			s = va_arg(va, const char *);
+			if (!s) {
+				v = dflt;
+				break;
 			}
+			v = va_arg(va, int);
 		}
+		va_end(va);
+		return v;
 	}
 	return dflt;
 }
 
 int
 get_attribute(
-	const list<TagAttribute> *as,
-	const char               *name, // Attribute name
+	const TagAttributes      *as,
+	AttributeName            name,  // Attribute name
 	const char               *dflt1,// If attribute not specified
 	int dflt2,                      // If string value does not match s1, ...
 	const char               *s1,
@@ -135,14 +117,12 @@ get_attribute(
 	...
 	)
 {
-	if (as) {
-		list<TagAttribute>::const_iterator i;
-		for (i = as->begin(); i != as->end(); ++i) {
-			if (cmp_nocase((*i).first, name) == 0) {
-				dflt1 = (*i).second.c_str();
-				break;
-			}
-		}
+	int i = as ? as->find(name) : -1;
+	string val;
+
+	if (i >= 0) {
+		val = as->raw_value(i);
+		dflt1 = val.c_str();
 	}
 
 	if (!dflt1)
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #ifdef AUTO_PTR_BROKEN /* { */
 #  define auto_ptr broken_auto_ptr
 #  include <memory>
@@ -39,23 +40,114 @@ using std::string;
 using std::pair;
 using std::list;
 
-typedef pair<string, istr> TagAttribute;
+/*
+ * The attribute names get_attribute() can be asked for, the scanner
+ * maps names to these, see attr_names[] in HTMLControl.cpp.  Attributes
+ * by any other name are not kept.
+ */
+enum AttributeName {
+	ATTR_ALIGN,
+	ATTR_ALT,
+	ATTR_BORDER,
+	ATTR_CHECKED,
+	ATTR_CODE,
+	ATTR_COLSPAN,
+	ATTR_HREF,
+	ATTR_MULTIPLE,
+	ATTR_NAME,
+	ATTR_ROWSPAN,
+	ATTR_SIZE,
+	ATTR_SRC,
+	ATTR_STYLE,
+	ATTR_TYPE,
+	ATTR_VALIGN,
+	ATTR_VALUE,
+	ATTR_WIDTH,
+	ATTR_UNKNOWN
+};
+
+/*
+ * The attributes of a start tag, in the order they were given.  Their
+ * values are the bytes the scanner found, either referenced in the
+ * input or kept back to back in src, and only decoded once
+ * get_attribute() asks for them.
+ */
+class TagAttributes {
+	public:
+		void add(AttributeName id, const unsigned char *value, size_t len)
+		{
+			Attribute a = { id, NULL, src.length(), len };
+			src.append((const char *)value, len);
+			attrs.push_back(a);
+		}
+		/* add a value from input that outlives the document, which
+		 * is not copied */
+		void add_view(AttributeName id,
+				const unsigned char *value, size_t len)
+		{
+			Attribute a = { id, value, 0, len };
+			attrs.push_back(a);
+		}
+		void add(AttributeName id, const istr &value)
+		{
+			const char *s = value.c_str();
+			add(id, (const unsigned char *)s, strlen(s));
+		}
+
+		/* the index of attribute id, or -1 if it is not there */
+		int find(AttributeName id) const
+		{
+			for (size_t i = 0; i < attrs.size(); i++) {
+				if (attrs[i].id == id)
+					return (int)i;
+			}
+			return -1;
+		}
+		/* the undecoded UTF-8 of the value */
+		string raw_value(size_t i) const
+		{
+			return string((const char *)data(i), attrs[i].len);
+		}
+		istr value(size_t i) const
+		{
+			istr ret;
+			return ret.append(data(i), attrs[i].len);
+		}
+
+	private:
+		/* a value is at view, or else at offset value in src */
+		struct Attribute {
+			AttributeName id;
+			const unsigned char *view;
+			size_t value;
+			size_t len;
+		};
+
+		const unsigned char *data(size_t i) const
+		{
+			return attrs[i].view != NULL ? attrs[i].view :
+				(const unsigned char *)src.data() + attrs[i].value;
+		}
+
+		string src;
+		std::vector<Attribute> attrs;
+};
 
 istr get_attribute(
-	const list<TagAttribute> *, const char *name, const char *dflt
+	const TagAttributes *, AttributeName name, const char *dflt
 	);
 istr get_attribute(
-	const list<TagAttribute> *, const char *name, bool *exists
+	const TagAttributes *, AttributeName name, bool *exists
 	);
 int get_attribute(
-	const list<TagAttribute> *, const char *name, int dflt
+	const TagAttributes *, AttributeName name, int dflt
 	);
 int get_attribute(
-	const list<TagAttribute> *, const char *name, int dflt,
+	const TagAttributes *, AttributeName name, int dflt,
 	const char *s1, int v1, ... /* ... NULL */
 	);
 int get_attribute(
-	const list<TagAttribute> *, const char *name, const char *dflt1, int dflt2,
+	const TagAttributes *, AttributeName name, const char *dflt1, int dflt2,
 	const char *s1, int v1, ... /* ... NULL */
 	);
 
@@ -96,6 +188,12 @@ struct Element {
 
 struct PCData : public Element {
 	istr text;
+	/* unless view is set, then the text is the viewlen bytes of UTF-8
+	 * there, straight from the input, which outlives the document */
+	const unsigned char *view;
+	size_t viewlen;
+
+	PCData(): view(NULL), viewlen(0) {}
 
 	/*virtual*/ PCData *to_PCData()
 	{
@@ -128,7 +226,7 @@ struct Phrase : public Element {
 };
 
 struct Font2 : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// SIZE COLOR
+	auto_ptr<TagAttributes>       attributes;// SIZE COLOR
 	auto_ptr<list<auto_ptr<Element> > > elements;
 
 	/*virtual*/ Line *line_format() const;
@@ -136,7 +234,7 @@ struct Font2 : public Element {
 };
 
 struct Anchor : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// NAME HREF REL REV TITLE
+	auto_ptr<TagAttributes>       attributes;// NAME HREF REL REV TITLE
 	auto_ptr<list<auto_ptr<Element> > > texts;
 	mutable int                         refnum;
 
@@ -145,31 +243,31 @@ struct Anchor : public Element {
 };
 
 struct BaseFont : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // SIZE
+	auto_ptr<TagAttributes> attributes; // SIZE
 
 };
 
 struct LineBreak : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // CLEAR
+	auto_ptr<TagAttributes> attributes; // CLEAR
 
 	/*virtual*/ Line *line_format() const;
 };
 
 struct Map : public Element {
-	auto_ptr<list<TagAttribute> >                   attributes;// NAME
-	auto_ptr<list<auto_ptr<list<TagAttribute> > > > areas;
+	auto_ptr<TagAttributes>                   attributes;// NAME
+	auto_ptr<list<auto_ptr<TagAttributes> > > areas;
 
 };
 
 struct Paragraph : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// ALIGN
+	auto_ptr<TagAttributes>       attributes;// ALIGN
 	auto_ptr<list<auto_ptr<Element> > > texts;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
 };
 
 struct Image : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // SRC ALT ALIGN WIDTH HEIGHT
+	auto_ptr<TagAttributes> attributes; // SRC ALT ALIGN WIDTH HEIGHT
 	// BORDER HSPACE VSPACE USEMAP
 	// ISMAP
 
@@ -177,7 +275,7 @@ struct Image : public Element {
 };
 
 struct Applet : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// CODEBASE CODE ALT NAME
+	auto_ptr<TagAttributes>       attributes;// CODEBASE CODE ALT NAME
 	// WIDTH HEIGHT ALIGN HSPACE
 	// VSPACE
 	auto_ptr<list<auto_ptr<Element> > > content;
@@ -187,12 +285,12 @@ struct Applet : public Element {
 };
 
 struct Param : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // NAME VALUE
+	auto_ptr<TagAttributes> attributes; // NAME VALUE
 
 };
 
 struct Division : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// ALIGN
+	auto_ptr<TagAttributes>       attributes;// ALIGN
 	auto_ptr<list<auto_ptr<Element> > > body_content;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
@@ -220,47 +318,47 @@ struct Address : public Element {
 };
 
 struct Form : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// ACTION METHOD ENCTYPE
+	auto_ptr<TagAttributes>       attributes;// ACTION METHOD ENCTYPE
 	auto_ptr<list<auto_ptr<Element> > > content;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
 };
 
 struct Input : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // TYPE NAME VALUE CHECKED SIZE
+	auto_ptr<TagAttributes> attributes; // TYPE NAME VALUE CHECKED SIZE
 	// MAXLENGTH SRC ALIGN
 
 	/*virtual*/ Line *line_format() const;
 };
 
 struct Option {
-	auto_ptr<list<TagAttribute> > attributes; // SELECTED VALUE
+	auto_ptr<TagAttributes> attributes; // SELECTED VALUE
 	auto_ptr<PCData>              pcdata;
 };
 
 struct Select : public Element {
-	auto_ptr<list<TagAttribute> >      attributes;// NAME SIZE MULTIPLE
+	auto_ptr<TagAttributes>      attributes;// NAME SIZE MULTIPLE
 	auto_ptr<list<auto_ptr<Option> > > content;
 
 	/*virtual*/ Line *line_format() const;
 };
 
 struct TextArea : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // NAME ROWS COLS
+	auto_ptr<TagAttributes> attributes; // NAME ROWS COLS
 	auto_ptr<PCData>              pcdata;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
 };
 
 struct Preformatted : public Element {
-	auto_ptr<list<TagAttribute> >       attributes;// WIDTH
+	auto_ptr<TagAttributes>       attributes;// WIDTH
 	auto_ptr<list<auto_ptr<Element> > > texts;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
 };
 
 struct Body {
-	auto_ptr<list<TagAttribute> >       attributes;// BACKGROUND BGCOLOR TEXT
+	auto_ptr<TagAttributes>       attributes;// BACKGROUND BGCOLOR TEXT
 	// LINK VLINK ALINK
 	auto_ptr<list<auto_ptr<Element> > > content;
 
@@ -276,31 +374,31 @@ struct Body {
 };
 
 struct Script {
-	auto_ptr<list<TagAttribute> > attributes; // LANGUAGE, ???
+	auto_ptr<TagAttributes> attributes; // LANGUAGE, ???
 	string text;
 };
 
 struct Style {
-	auto_ptr<list<TagAttribute> > attributes; // ???
+	auto_ptr<TagAttributes> attributes; // ???
 	string text;
 };
 
 struct Meta {
-	auto_ptr<list<TagAttribute> > attributes;    // HTTP-EQUIV NAME CONTENT
+	auto_ptr<TagAttributes> attributes;    // HTTP-EQUIV NAME CONTENT
 };
 
 struct Head {
 	auto_ptr<PCData>              title;
-	auto_ptr<list<TagAttribute> > isindex_attributes; // PROMPT
-	auto_ptr<list<TagAttribute> > base_attributes;  // HREF
+	auto_ptr<TagAttributes> isindex_attributes; // PROMPT
+	auto_ptr<TagAttributes> base_attributes;  // HREF
 	list<auto_ptr<Script> >       scripts;
 	list<auto_ptr<Style> >        styles;
 	list<auto_ptr<Meta> >         metas;
-	auto_ptr<list<TagAttribute> > link_attributes;  // HREF REL REV TITLE
+	auto_ptr<TagAttributes> link_attributes;  // HREF REL REV TITLE
 };
 
 struct Document {
-	auto_ptr<list<TagAttribute> > attributes; // VERSION
+	auto_ptr<TagAttributes> attributes; // VERSION
 	Head head;
 	Body body;
 
@@ -315,7 +413,7 @@ struct Document {
 
 struct Heading : public Element {
 	int level;
-	auto_ptr<list<TagAttribute> >       attributes;// ALIGN
+	auto_ptr<TagAttributes>       attributes;// ALIGN
 	auto_ptr<list<auto_ptr<Element> > > content;
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
@@ -329,19 +427,19 @@ struct TableHeadingCell : public TableCell {
 };
 
 struct TableRow {
-	auto_ptr<list<TagAttribute> >         attributes;// ALIGN VALIGN
+	auto_ptr<TagAttributes>         attributes;// ALIGN VALIGN
 	auto_ptr<list<auto_ptr<TableCell> > > cells;
 };
 
 struct Caption {
-	auto_ptr<list<TagAttribute> >       attributes;// ALIGN
+	auto_ptr<TagAttributes>       attributes;// ALIGN
 	auto_ptr<list<auto_ptr<Element> > > texts;
 
 	Area *format(Area::size_type w, int halign) const;
 };
 
 struct Table : public Element {
-	auto_ptr<list<TagAttribute> >        attributes;// ALIGN WIDTH BORDER
+	auto_ptr<TagAttributes>        attributes;// ALIGN WIDTH BORDER
 	// CELLSPACING CELLPADDING
 	auto_ptr<Caption>                    caption;
 	auto_ptr<list<auto_ptr<TableRow> > > rows;
@@ -356,7 +454,7 @@ struct NoBreak : public Element {
 };
 
 struct HorizontalRule : public Element {
-	auto_ptr<list<TagAttribute> > attributes; // ALIGN NOSHADE SIZE WIDTH
+	auto_ptr<TagAttributes> attributes; // ALIGN NOSHADE SIZE WIDTH
 
 	/*virtual*/ Area *format(Area::size_type w, int halign) const;
 };
@@ -373,7 +471,7 @@ struct ListItem {
 };
 
 struct ListNormalItem : public ListItem {
-	auto_ptr<list<TagAttribute> >       attributes;// TYPE VALUE
+	auto_ptr<TagAttributes>       attributes;// TYPE VALUE
 	auto_ptr<list<auto_ptr<Element> > > flow;
 
 	/*virtual*/ Area *format(
@@ -396,7 +494,7 @@ struct ListBlockItem : public ListItem {
 };
 
 struct OrderedList : public Element {
-	auto_ptr<list<TagAttribute> >        attributes;// TYPE START COMPACT
+	auto_ptr<TagAttributes>        attributes;// TYPE START COMPACT
 	auto_ptr<list<auto_ptr<ListItem> > > items;
 	int nesting;
 	// Item indentation depends on on the list nesting level.
@@ -405,7 +503,7 @@ struct OrderedList : public Element {
 };
 
 struct UnorderedList : public Element {
-	auto_ptr<list<TagAttribute> >        attributes;// TYPE COMPACT
+	auto_ptr<TagAttributes>        attributes;// TYPE COMPACT
 	auto_ptr<list<auto_ptr<ListItem> > > items;
 	int nesting;
 
@@ -413,7 +511,7 @@ struct UnorderedList : public Element {
 };
 
 struct Dir : public Element {
-	auto_ptr<list<TagAttribute> >        attributes;// COMPACT
+	auto_ptr<TagAttributes>        attributes;// COMPACT
 	auto_ptr<list<auto_ptr<ListItem> > > items;
 	int nesting;
 
@@ -421,7 +519,7 @@ struct Dir : public Element {
 };
 
 struct Menu : public Element {
-	auto_ptr<list<TagAttribute> >        attributes;// COMPACT
+	auto_ptr<TagAttributes>        attributes;// COMPACT
 	auto_ptr<list<auto_ptr<ListItem> > > items;
 	int nesting;
 
@@ -447,7 +545,7 @@ struct TermDefinition : public DefinitionListItem {
 };
 
 struct DefinitionList : public Element {
-	auto_ptr<list<TagAttribute> >                  attributes;// COMPACT
+	auto_ptr<TagAttributes>                  attributes;// COMPACT
 	auto_ptr<list<auto_ptr<Element> > >            preamble;
 	auto_ptr<list<auto_ptr<DefinitionListItem> > > items;
 
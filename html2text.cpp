@@ -25,6 +25,7 @@
 #include "HTMLDriver.h"
 #include "iconvstream.h"
 #include "format.h"
+#include "head.h"
 
 #define stringify(x) stringify2(x)
 #define stringify2(x) #x
@@ -33,15 +34,18 @@ static const char *usage = "\
 Usage:\n\
   html2text -help\n\
   html2text -version\n\
-  html2text [ -check ] [ -debug-scanner ] [ -debug-parser ] \\\n\
+  html2text [ -check | -head ] [ -debug-scanner ] [ -debug-parser ] \\\n\
      [ -rcfile <file> ] [ -width <w> ] [ -nobs ] [ -links ]\\\n\
      [ -from_encoding ] [ -to_encoding ] [ -ascii ]\\\n\
+     [ -flush <policy> ] [ -readahead ] [ -stats ]\\\n\
      [ -o <file> ] [ <input-file> ] ...\n\
 Formats HTML document(s) read from <input-file> or STDIN and generates ASCII\n\
 text.\n\
   -help          Print this text and exit\n\
   -version       Print program version and copyright notice\n\
   -check         Do syntax checking only\n\
+  -head          Print only the title, base URL and charset, reading no\n\
+                 further than the end of the HEAD\n\
   -debug-scanner Report parsed tokens on STDERR (debugging)\n\
   -debug-parser  Report parser activity on STDERR (debugging)\n\
   -rcfile <file> Read <file> instead of \"$HOME/.html2textrc\"\n\
@@ -54,6 +58,12 @@ text.\n\
                  alias for: -to_encoding ASCII//TRANSLIT \n\
   -utf8          Assume both terminal and input stream are in UTF-8 mode\n\
                  alias for: -from_encoding UTF-8 -to_encoding UTF-8 \n\
+  -flush <policy> Write output on every block, every <n> bytes, or\n\
+                 never until the end: one of block, never or <n>,\n\
+                 defaults to block for terminals, 262144 otherwise\n\
+  -readahead     Read and decode input from pipes in a separate thread\n\
+  -stats         Report read and write calls, invalid input and discarded\n\
+                 content on STDERR\n\
   -o <file>      Redirect output into <file>\n\
 ";
 
@@ -97,6 +107,12 @@ main(int argc, char **argv)
 	const char *from_encoding = NULL;
 	const char *to_encoding = NULL;
 	const char *widthstr = NULL;
+	const char *flushstr = NULL;
+	int flush_policy = iconvstream::FLUSH_AUTO;
+	size_t flush_size = 0;
+	bool print_stats = false;
+	struct HTMLControl::discard_stats discarded;
+	bool readahead = false;
 	const char **extarg = NULL;
 
 	int i;
@@ -105,6 +121,8 @@ main(int argc, char **argv)
 
 		if (!strcmp(arg, "-check")) {
 			mode = HTMLDriver::SYNTAX_CHECK;
+		} else if (!strcmp(arg, "-head")) {
+			mode = HTMLDriver::HEAD_ONLY;
 		} else if (!strcmp(arg, "-debug-scanner")) {
 			debug_scanner = true;
 		} else if (!strcmp(arg, "-debug-parser")) {
@@ -125,6 +143,12 @@ main(int argc, char **argv)
 			extarg = &to_encoding;
 		} else if (!strcmp(arg, "-ascii")) {
 			to_encoding = "ASCII//TRANSLIT";  /* create things like (c) */
+		} else if (!strcmp(arg, "-flush")) {
+			extarg = &flushstr;
+		} else if (!strcmp(arg, "-readahead")) {
+			readahead = true;
+		} else if (!strcmp(arg, "-stats")) {
+			print_stats = true;
 		} else if (!strcmp(arg, "-utf8")) {
 			from_encoding = "UTF-8";
 			to_encoding = "UTF-8";
@@ -147,8 +171,24 @@ main(int argc, char **argv)
 			}
 			*extarg = argv[i];
 
-			/* handle the only integer argument inline */
-			if (extarg == &widthstr) {
+			/* handle arguments that need parsing inline */
+			if (extarg == &flushstr) {
+				int nsize;
+				if (!strcmp(flushstr, "block")) {
+					flush_policy = iconvstream::FLUSH_BLOCK;
+				} else if (!strcmp(flushstr, "never")) {
+					flush_policy = iconvstream::FLUSH_NEVER;
+				} else if ((nsize = atoi(flushstr)) > 0) {
+					flush_policy = iconvstream::FLUSH_SIZE;
+					flush_size = nsize;
+				} else {
+					std::cerr
+						<< "flush policy '" << flushstr << "' invalid, "
+						<< "must be block, never or a size"
+						<< std::endl;
+					exit(1);
+				}
+			} else if (extarg == &widthstr) {
 				int nwidth = atoi(widthstr);
 				if (nwidth > 10) {
 					width = nwidth;
@@ -194,9 +234,12 @@ main(int argc, char **argv)
 
 	{
 		std::ifstream ifs;
+		string homerc;
 
-		if (rcfile == NULL && home != NULL)
-			rcfile = (string(home) + "/.html2textrc").c_str();
+		if (rcfile == NULL && home != NULL) {
+			homerc = string(home) + "/.html2textrc";
+			rcfile = homerc.c_str();
+		}
 		if (rcfile != NULL)
 			ifs.open(rcfile);
 		if (rcfile == NULL || !ifs.rdbuf()->is_open())
@@ -212,6 +255,9 @@ main(int argc, char **argv)
 
 	iconvstream is;
 
+	memset(&discarded, 0, sizeof(discarded));
+	is.set_flush_policy(flush_policy, flush_size);
+	is.set_readahead(readahead);
 	is.open_os(output_file_name, to_encoding);
 	if (!is.os_open()) {
 		std::cerr
@@ -237,18 +283,52 @@ main(int argc, char **argv)
 				<< "\": "
 				<< is.open_error_msg()
 				<< std::endl;
+			is.close();  /* write what we have so far */
 			exit(1);
 		}
 
 		HTMLControl control(is, mode, debug_scanner, input_file);
+
+		if (mode == HTMLDriver::HEAD_ONLY) {
+			/* the rest of the input is left unread */
+			print_head(control, is);
+			is.close_is();
+			continue;
+		}
+
 		HTMLDriver driver(control, is, enable_links,
 				width, mode, debug_parser);
 
-		if (driver.parse() != 0)
+		/* we never look at scripts, styles and the like */
+		control.set_discard(true);
+		if (driver.parse() != 0) {
+			is.close();
 			exit(1);
+		}
+
+		const struct HTMLControl::discard_stats &ds =
+			control.get_discard_stats();
+		discarded.script += ds.script;
+		discarded.style += ds.style;
+		discarded.meta += ds.meta;
+		discarded.comment += ds.comment;
 	}
 
 	is.close();
 
+	if (print_stats) {
+		const struct iconvstream::stats &st = is.get_stats();
+		std::cerr
+			<< "input:  " << st.bytes_in << " bytes, "
+			<< st.read_calls << " read calls, "
+			<< st.replaced_in << " invalid bytes replaced" << std::endl
+			<< "output: " << st.bytes_out << " bytes, "
+			<< st.write_calls << " write calls" << std::endl
+			<< "discarded: " << discarded.script << " bytes of SCRIPT, "
+			<< discarded.style << " of STYLE, "
+			<< discarded.meta << " of META, "
+			<< discarded.comment << " of comments" << std::endl;
+	}
+
 	return 0;
 }
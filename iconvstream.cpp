@@ -15,50 +15,130 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 #include <ctype.h>
 #include <errno.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <limits.h>
 #include <fcntl.h>
-#include <errno.h>
 #include <iconv.h>
 
 #include <iostream>
 #include "iconvstream.h"
+#include "utf8.h"
+#include "charsets.h"
+
+#ifndef nelems
+#define nelems(array) (sizeof(array) / sizeof((array)[0]))
+#endif
+
+/* number of bytes looked at for the charset declaration, matches w3c's
+ * req for content type declaration */
+static const size_t SNIFFSZE = 1024;
+/* read() buffers start at this size, and double while reads fill them
+ * entirely, which is what pipes with a fast writer do */
+static const size_t READBUFSZE_MIN = 64 * 1024;
+static const size_t READBUFSZE_MAX = 1024 * 1024;
+/* amount of input bytes fed to iconv per call */
+static const size_t CONVCHUNKSZE = 64 * 1024;
+/* output is converted in chunks of this size */
+static const size_t WRITEBUFSZE = 64 * 1024;
+/* when not writing to a terminal, output is written once this much
+ * is pending */
+static const size_t OUTFLUSHSZE = 256 * 1024;
+/* size of each slot in the read-ahead ring */
+static const size_t READAHEADSZE = 64 * 1024;
+/* max number of buffers handed to a single writev() */
+#ifdef IOV_MAX
+static const size_t OUTIOVMAX = IOV_MAX;
+#else
+static const size_t OUTIOVMAX = 16;
+#endif
 
 void
 iconvstream::open_is(const char *file_name, const char *encoding_in)
 {
+	struct stat st;
+	off_t off;
+
 	close_is();
 
+	open_err = 0;
 	encoding = encoding_in;
 
 	fd_is =
 		strcmp(file_name, "-") == 0 ? ::dup(0) : ::open(file_name, O_RDONLY);
-	if (fd_is == -1)
+	if (fd_is == -1) {
 		open_err = strerror(errno);
+		return;
+	}
 
-	readbufsze = 1024;  /* matches w3c's req for content type declaration */
-	rutf8bufsze = readbufsze * 4;
-	readbuflen = 0;
-	rutf8buflen = 0;
-	readbufpos = 0;
-	rutf8bufpos = 0;
-	readbuf = new unsigned char[readbufsze];
-	rutf8buf = new unsigned char[rutf8bufsze];
+	reset_is();
+
+	/* regular files (also when given as stdin) are mapped in one go, so
+	 * we don't need any read() calls at all */
+	if (fstat(fd_is, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+			(off = lseek(fd_is, 0, SEEK_CUR)) == 0)
+	{
+		void *m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+				fd_is, 0);
+		if (m != MAP_FAILED) {
+			mapbuf = (unsigned char *)m;
+			mapbufsze = (size_t)st.st_size;
+			(void)madvise(m, mapbufsze, MADV_SEQUENTIAL);
+			inbuflen = mapbufsze;
+			inbufeof = true;
+			iostats.bytes_in += mapbufsze;
+		}
+	}
+	if (mapbuf == NULL && readbuf == NULL) {
+		readbufsze = READBUFSZE_MIN;
+		readbuf = new unsigned char[readbufsze];
+	}
+	inbuf = mapbuf != NULL ? mapbuf : readbuf;
 
-	/* trigger charset detection, and reset the pointer afterwards,
-	 * doing this now generates an error if the charset is invalid,
-	 * which is not expected to be set during reading */
-	if (!open_err) {
-		get();
-		rutf8bufpos = 0;
-		if (open_err) {
+	if (readahead && mapbuf == NULL) {
+		size_t i;
+
+		/* detect the charset here, so an invalid one is an error
+		 * of the open, then leave all reading to the thread */
+		if (!setup_is() && open_err) {
 			close_is();
-			fd_is = -1;
+			return;
 		}
+		for (i = 0; i < nelems(readahead_slots); i++) {
+			if (readahead_slots[i].buf == NULL)
+				readahead_slots[i].buf = new unsigned char[READAHEADSZE];
+		}
+		readahead_prod = 0;
+		readahead_cons = 0;
+		readahead_holding = false;
+		readahead_eof = false;
+		sem_init(&readahead_filled, 0, 0);
+		sem_init(&readahead_free, 0, nelems(readahead_slots));
+		if (pthread_create(&readahead_thread, NULL,
+					readahead_main, this) == 0)
+		{
+			readahead_running = true;
+		} else {
+			/* just do without */
+			sem_destroy(&readahead_filled);
+			sem_destroy(&readahead_free);
+		}
+		return;
 	}
+
+	/* trigger charset detection, and reset the pointer afterwards,
+	 * doing this now generates an error if the charset is invalid,
+	 * which is not expected to be set during reading */
+	get();
+	rutf8bufpos = 0;
+	if (open_err)
+		close_is();
 }
 
 void
@@ -67,26 +147,188 @@ iconvstream::open_is(const string &url, const char *encoding)
 	open_is(url.c_str(), encoding);
 }
 
+/*
+ * Open input that is handed to us with push() instead of read from a
+ * file, the decoded input then runs out (starved()) whenever all that
+ * was pushed is consumed, until push_eof() marks the end.
+ */
+void
+iconvstream::open_push(const char *encoding_in)
+{
+	close_is();
+
+	open_err = 0;
+	encoding = encoding_in;
+	push_is = true;
+
+	reset_is();
+	if (readbuf == NULL) {
+		readbufsze = READBUFSZE_MIN;
+		readbuf = new unsigned char[readbufsze];
+	}
+	inbuf = readbuf;
+}
+
+/*
+ * Add len bytes of input for open_push().  Pushing invalidates the
+ * spans handed out before, so only push once the input ran out.
+ */
+void
+iconvstream::push(const void *buf, size_t len)
+{
+	size_t pending = inbuflen - inbufpos;
+
+	if (!push_is || inbufeof)
+		return;
+
+	/* keep the bytes not consumed yet, e.g. a truncated multibyte
+	 * sequence, and make room for the new ones */
+	if (inbufpos > 0) {
+		memmove(readbuf, readbuf + inbufpos, pending);
+		inbuflen = pending;
+		inbufpos = 0;
+	}
+	if (inbuflen + len > readbufsze) {
+		unsigned char *nbuf;
+
+		while (inbuflen + len > readbufsze)
+			readbufsze *= 2;
+		nbuf = new unsigned char[readbufsze];
+		memcpy(nbuf, readbuf, inbuflen);
+		delete[] readbuf;
+		inbuf = readbuf = nbuf;
+	}
+	memcpy(readbuf + inbuflen, buf, len);
+	inbuflen += len;
+	iostats.bytes_in += len;
+}
+
+/*
+ * Mark the end of the input for open_push().
+ */
+void
+iconvstream::push_eof(void)
+{
+	if (push_is)
+		inbufeof = true;
+}
+
+/*
+ * Reset the input state for a new document.
+ */
+void
+iconvstream::reset_is(void)
+{
+	mapbuf = NULL;
+	mapbufsze = 0;
+	inbuflen = 0;
+	inbufpos = 0;
+	inbufeof = false;
+	readbufgrow = false;
+
+	utf8_passthrough = false;
+	charset_is = NULL;
+	if (rconvbuf == NULL) {
+		rconvbufsze = CONVCHUNKSZE * 4;  /* worst case scenario UTF-32 */
+		rconvbuf = new unsigned char[rconvbufsze];
+	}
+	rutf8buf = rconvbuf;
+	rutf8buflen = 0;
+	rutf8bufpos = 0;
+}
+
 void
 iconvstream::close_is(void)
 {
-	if (is_open()) {
+	if (readahead_running) {
+		/* the thread is either blocked in read() or sem_wait(), both
+		 * are cancellation points */
+		pthread_cancel(readahead_thread);
+		pthread_join(readahead_thread, NULL);
+		sem_destroy(&readahead_filled);
+		sem_destroy(&readahead_free);
+		readahead_running = false;
+	}
+	if (fd_is >= 0) {
 		::close(fd_is);
-		delete readbuf;
-		delete rutf8buf;
+		fd_is = -1;
+		if (mapbuf != NULL)
+			munmap(mapbuf, mapbufsze);
+		mapbuf = NULL;
+	}
+	push_is = false;
+	/* the descriptor stays in the cache */
+	iconv_handle_is = iconv_t(-1);
+}
+
+iconvstream::~iconvstream()
+{
+	size_t i;
+
+	close();
+	delete[] readbuf;
+	delete[] rconvbuf;
+	for (i = 0; i < nelems(readahead_slots); i++)
+		delete[] readahead_slots[i].buf;
+	for (i = 0; i < nelems(iconv_cache); i++) {
+		if (!iconv_cache[i].encoding.empty())
+			iconv_close(iconv_cache[i].cd);
 	}
 }
 
+/*
+ * Return a descriptor converting from "encoding" to UTF-8 in its
+ * initial state, from the cache if possible.
+ */
+iconv_t
+iconvstream::iconv_get(const char *encoding)
+{
+	iconv_t cd;
+	size_t i;
+
+	for (i = 0; i < nelems(iconv_cache); i++) {
+		if (!iconv_cache[i].encoding.empty() &&
+				strcasecmp(iconv_cache[i].encoding.c_str(), encoding) == 0)
+		{
+			cd = iconv_cache[i].cd;
+			(void)iconv(cd, NULL, NULL, NULL, NULL);
+			return cd;
+		}
+	}
+
+	cd = iconv_open("UTF-8", encoding);
+	if (cd == iconv_t(-1))
+		return cd;
+
+	/* replace the oldest entry */
+	i = iconv_cache_next++ % nelems(iconv_cache);
+	if (!iconv_cache[i].encoding.empty())
+		iconv_close(iconv_cache[i].cd);
+	iconv_cache[i].encoding = encoding;
+	iconv_cache[i].cd = cd;
+
+	return cd;
+}
+
 void
 iconvstream::open_os(const char *file_name, const char *encoding)
 {
 	close_os();
 
-	/* internal processing uses UTF-8 */
-	iconv_handle_os = iconv_open(encoding, "UTF-8");
-	if (iconv_handle_os == iconv_t(-1)) {
-		open_err = "invalid to_encoding";
-		return;
+	/* internal processing uses UTF-8, so for UTF-8 output we only
+	 * need to make sure we don't emit anything invalid */
+	utf8_sink = strcasecmp(encoding, "UTF-8") == 0 ||
+		strcasecmp(encoding, "UTF8") == 0;
+	/* transliterating through iconv depends on the locale and is slow,
+	 * for ASCII we have our own table */
+	translit_sink = charset_is_ascii_translit(encoding);
+	iconv_handle_os = iconv_t(-1);
+	if (!utf8_sink && !translit_sink) {
+		iconv_handle_os = iconv_open(encoding, "UTF-8");
+		if (iconv_handle_os == iconv_t(-1)) {
+			open_err = "invalid to_encoding";
+			return;
+		}
 	}
 
 	fd_os = strcmp(file_name, "-") == 0 ?
@@ -96,14 +338,26 @@ iconvstream::open_os(const char *file_name, const char *encoding)
 	if (fd_os == -1)
 		open_err = strerror(errno);
 
-	writebufsze = 1024;
-	wutf8bufsze = writebufsze * 4;  /* worst case scenario UTF-32 */
-	writebuflen = 0;
-	wutf8buflen = 0;
+	/* someone looking at the output wants to see it as it is made,
+	 * anyone else is better off with as few writes as possible */
+	if (flush_policy == FLUSH_AUTO) {
+		if (fd_os != -1 && isatty(fd_os)) {
+			flush_policy = FLUSH_BLOCK;
+		} else {
+			flush_policy = FLUSH_SIZE;
+			flush_size = OUTFLUSHSZE;
+		}
+	}
+
+	writebufsze = WRITEBUFSZE;
 	writebufpos = 0;
-	wutf8bufpos = 0;
 	writebuf = new unsigned char[writebufsze];
-	wutf8buf = new unsigned char[wutf8bufsze];
+	/* for UTF-8 writebuf itself is queued for output */
+	outbufsze = utf8_sink ? writebufsze :
+		writebufsze * 4;  /* worst case scenario UTF-32 */
+	outiov.clear();
+	outbufs.clear();
+	outiovlen = 0;
 }
 
 void
@@ -116,155 +370,505 @@ void
 iconvstream::close_os(void)
 {
 	if (os_open()) {
-		*this << flush;
+		size_t i;
+
+		(void)encode_os(true);
+		(void)write_os();
 		::close(fd_os);
-		delete writebuf;
-		delete wutf8buf;
+		fd_os = -1;
+		delete[] writebuf;
+		for (i = 0; i < outfree.size(); i++)
+			delete[] outfree[i];
+		outfree.clear();
+		if (iconv_handle_os != iconv_t(-1)) {
+			iconv_close(iconv_handle_os);
+			iconv_handle_os = iconv_t(-1);
+		}
 	}
 }
 
-static const char *
-find_tokens(char *buf, size_t len, const char **tokens)
+void
+iconvstream::set_flush_policy(int policy, size_t size)
 {
-	char        *startp     = NULL;
-	char        *curp;
-	const char **curtoken   = tokens;
-	char         startfound = 0;
-
-	for (curp = buf; (size_t)(curp - buf) < len; curp++) {
-		/* [a-zA-Z0-9/-]+ */
-		if ((*curp >= 'a' && *curp <= 'z') ||
-			(*curp >= 'A' && *curp <= 'Z') ||
-			(*curp >= '0' && *curp <= '9') ||
-			*curp == '/' || *curp == '-')
-		{
-			if (startp == NULL)
-				startp = curp;
+	flush_policy = policy;
+	flush_size = size;
+}
+
+const char *
+iconvstream::open_error_msg() const
+{
+	return open_err ? open_err : "No error";
+}
+
+/*
+ * Pull more input into inbuf, returns false when no more input can be
+ * obtained.
+ */
+bool
+iconvstream::fill_is()
+{
+	ssize_t r;
+	size_t pending;
+
+	/* pushed input only comes in through push() */
+	if (inbufeof || push_is)
+		return false;
+
+	/* keep the bytes not consumed yet, e.g. a truncated multibyte
+	 * sequence, and make room for more */
+	pending = inbuflen - inbufpos;
+	if (inbufpos > 0) {
+		memmove(readbuf, readbuf + inbufpos, pending);
+		inbuflen = pending;
+		inbufpos = 0;
+	}
+	/* the last read filled all space we had, so grow for this one */
+	if (readbufgrow && readbufsze < READBUFSZE_MAX) {
+		unsigned char *nbuf = new unsigned char[readbufsze * 2];
+		memcpy(nbuf, readbuf, inbuflen);
+		delete[] readbuf;
+		inbuf = readbuf = nbuf;
+		readbufsze *= 2;
+	}
+
+	r = read(fd_is, readbuf + inbuflen, readbufsze - inbuflen);
+	iostats.read_calls++;
+	if (r <= 0) {
+		inbufeof = true;
+		return false;
+	}
+	readbufgrow = (size_t)r == readbufsze - inbuflen;
+	inbuflen += r;
+	iostats.bytes_in += r;
+
+	return true;
+}
+
+/*
+ * Make the next chunk of decoded input available in rutf8buf, returns
+ * false on EOF.
+ */
+bool
+iconvstream::underflow()
+{
+	rutf8bufpos = 0;
+	rutf8buflen = 0;
+
+	if (readahead_running) {
+		struct readahead_slot *slot;
+
+		if (readahead_eof)
+			return false;
+		/* the slot we were reading from can be filled again */
+		if (readahead_holding) {
+			sem_post(&readahead_free);
+			readahead_cons = (readahead_cons + 1) % nelems(readahead_slots);
 		}
-		else
-		{
-			if (startp != NULL) {
-				if (*curtoken == NULL) {
-					return strndup(startp, curp - startp);  /* LEAK */
-				} else if (strlen(*curtoken) == (size_t)(curp - startp) &&
-						   strncasecmp(*curtoken, startp, curp - startp) == 0)
-				{
-					if (startfound != 0 || startp[-1] == '<') {
-						startfound = 1;
-						curtoken++;
-					}
-				} else if (startfound == 1) {
-					startfound = 0;
-					curtoken   = tokens;
-				}
-			}
-			startp = NULL;
+		while (sem_wait(&readahead_filled) != 0)
+			;
+		readahead_holding = true;
+		slot = &readahead_slots[readahead_cons];
+		if (slot->len == 0) {
+			readahead_eof = true;
+			return false;
 		}
+		rutf8buf = slot->buf;
+		rutf8buflen = slot->len;
+		return true;
 	}
 
+	return decode(&rutf8buf, &rutf8buflen);
+}
+
+void *
+iconvstream::readahead_main(void *arg)
+{
+	((iconvstream *)arg)->readahead_run();
 	return NULL;
 }
 
-const char *
-iconvstream::open_error_msg() const
+/*
+ * Producer side of the read-ahead: decode the input into free slots of
+ * the ring, and hand them to underflow().  An empty slot marks EOF.
+ */
+void
+iconvstream::readahead_run()
 {
-	return open_err ? open_err : "No error";
+	const unsigned char *win = NULL;
+	size_t winlen = 0;
+	bool eof = false;
+
+	for (;;) {
+		struct readahead_slot *slot =
+			&readahead_slots[readahead_prod];
+
+		while (sem_wait(&readahead_free) != 0)
+			;
+		slot->len = 0;
+		while (slot->len < READAHEADSZE) {
+			size_t n;
+
+			if (winlen == 0) {
+				/* don't hold on to what we have while waiting for
+				 * more input */
+				if (eof ||
+						(slot->len > 0 && inbufpos == inbuflen && !inbufeof))
+					break;
+				if (!decode(&win, &winlen)) {
+					eof = true;
+					break;
+				}
+			}
+
+			/* never split a character over two slots */
+			n = READAHEADSZE - slot->len;
+			if (n < winlen) {
+				while (n > 0 && (win[n] & 0xC0) == 0x80)
+					n--;
+				if (n == 0)
+					break;
+			} else {
+				n = winlen;
+			}
+			memcpy(slot->buf + slot->len, win, n);
+			slot->len += n;
+			win += n;
+			winlen -= n;
+		}
+		readahead_prod = (readahead_prod + 1) % nelems(readahead_slots);
+		sem_post(&readahead_filled);
+		if (slot->len == 0)
+			break;
+	}
 }
 
-int
-iconvstream::get()
+/*
+ * Figure out what encoding the input is in, unless a specific override
+ * is in place, and set up for decoding it, returns false on EOF or
+ * error.
+ */
+bool
+iconvstream::setup_is()
 {
-	if (rutf8bufpos == rutf8buflen) {
-		char *procinp = (char *)readbuf;
-		char *procout = (char *)rutf8buf;
+	/* only the first SNIFFSZE bytes are considered for this */
+	while (inbuflen < SNIFFSZE && fill_is())
+		;
+	/* wait for pushed input to fill the sniffing window */
+	if (inbuflen == 0 || (push_is && !inbufeof && inbuflen < SNIFFSZE))
+		return false;
+
+	if (strcmp(encoding, "auto") == 0) {
+		size_t snifflen = inbuflen < SNIFFSZE ? inbuflen : SNIFFSZE;
+
+		/* look for UTF-BOM, this should override any meta
+		 * declaration (feels like a safe way for M$ to screw
+		 * this up, but let's go with this for now)
+		 * https://www.w3.org/International/questions/qa-html-encoding-declarations#bom */
+		if (snifflen >= 2 && memcmp(inbuf, "\ufeff", 2) == 0) {
+			encoding = "UTF-8";
+		} else if (charset_prescan(inbuf, snifflen, sniffed_encoding,
+					sizeof(sniffed_encoding)))
+		{
+			/* declared in a meta tag, either
+			 * - <meta charset="utf-8"/>
+			 * - <meta http-equiv="Content-Type"
+			 *    content="text/html; charset=utf-8"/>
+			 * https://www.w3.org/International/questions/qa-html-encoding-declarations#quickanswer */
+			encoding = sniffed_encoding;
+		} else {
+			/* fall back to lame historical default */
+			encoding = "ISO-8859-1";
+		}
+	}
+
+	/* we always encode to UTF-8 for internal processing, for
+	 * which UTF-8 input only needs validation, and the common
+	 * single-byte charsets are a simple table lookup */
+	if (strcasecmp(encoding, "UTF-8") == 0 ||
+			strcasecmp(encoding, "UTF8") == 0)
+	{
+		utf8_passthrough = true;
+	} else if ((charset_is = charset_find(encoding)) == NULL) {
+		iconv_handle_is = iconv_get(encoding);
+		if (iconv_handle_is == iconv_t(-1) &&
+				encoding == sniffed_encoding)
+		{
+			/* the document declares something we don't know */
+			encoding = "ISO-8859-1";
+			charset_is = charset_find(encoding);
+		} else if (iconv_handle_is == iconv_t(-1)) {
+			open_err = "invalid from_encoding";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Convert the next chunk of input, returns false on EOF.  The result
+ * is valid until the next call.
+ */
+bool
+iconvstream::decode(const unsigned char **buf, size_t *len)
+{
+	bool needmore = false;
+
+	if (iconv_handle_is == iconv_t(-1) && !utf8_passthrough &&
+			charset_is == NULL && !setup_is())
+		return false;
+
+	for (;;) {
+		size_t avail = inbuflen - inbufpos;
+		size_t inplen;
+		size_t outlen;
+		char *procinp;
+		char *procout;
 		size_t iconvret;
 
-		readbuflen = read(fd_is, readbuf + readbufpos, readbufsze - readbufpos);
-		if (readbuflen <= 0)
-			return EOF;
-
-		if (rutf8buflen == 0) {
-			/* on first read, figure out what encoding this is, unless a
-		 	 * specific override is in place */
-			if (strcmp(encoding, "auto") == 0) {
-				/* look for UTF-BOM, this should override any meta
-				 * declaration (feels like a safe way for M$ to screw
-				 * this up, but let's go with this for now)
-				 * https://www.w3.org/International/questions/qa-html-encoding-declarations#bom */
-				if (readbuflen >= 2 && memcmp(readbuf, "\ufeff", 2) == 0) {
-					encoding = "UTF-8";
-				} else {
-					const char *tokens_charset[] = {
-						"meta", "charset", NULL
-					};
-					const char *tokens_contenttype[] = {
-						"meta", "http-equiv", "content-type",
-						"content", "text/html", "charset", NULL
-					};
-					/* hunt down meta, which can be two forms
-					 * - <meta charset="utf-8"/>
-					 * - <meta http-equiv="Content-Type"
-					 *    content="text/html; charset=utf-8"/>
-					 * https://www.w3.org/International/questions/qa-html-encoding-declarations#quickanswer
-					 * now there is the correct way, which would be to
-					 * parse whatever xml, and the quick 'n' dirty way,
-					 * which is to simply do some lame-@$$ parsing */
-					encoding = find_tokens((char *)readbuf, readbuflen,
-										   tokens_charset);
-					if (encoding == NULL) {
-						encoding = find_tokens((char *)readbuf, readbuflen,
-											   tokens_contenttype);
-					}
-					/* fall back to lame historical default */
-					if (encoding == NULL)
-						encoding = "ISO-8859-1";
-				}
-			}
+		if (avail == 0 || needmore) {
+			/* anything left here at EOF is a truncated sequence,
+			 * which we drop */
+			if (!fill_is())
+				return false;
+			needmore = false;
+			continue;
+		}
 
-			/* we always encode to UTF-8 for internal processing */
-			iconv_handle_is = iconv_open("UTF-8", encoding);
-			if (iconv_handle_is == iconv_t(-1)) {
-				open_err = "invalid from_encoding";
-				return 0;
+		if (utf8_passthrough) {
+			bool truncated;
+			size_t validlen;
+
+			/* validate no more than a chunk ahead of what is read,
+			 * such that a mapped file is not gone through as a whole
+			 * before the first of it is used */
+			validlen = utf8_validate(inbuf + inbufpos,
+					avail < CONVCHUNKSZE ? avail : CONVCHUNKSZE,
+					&truncated);
+			if (validlen > 0) {
+				/* hand out the input as is, fill_is() won't touch it
+				 * until get() consumed all of it */
+				*buf = inbuf + inbufpos;
+				*len = validlen;
+				inbufpos += validlen;
+				return true;
 			}
+			if (truncated) {
+				needmore = true;
+				continue;
+			}
+			/* replace the whole run of invalid bytes in one go, a '?'
+			 * for each, like we do for iconv */
+			if (avail > rconvbufsze)
+				avail = rconvbufsze;
+			*len = utf8_invalid_run(inbuf + inbufpos, avail);
+			memset(rconvbuf, '?', *len);
+			*buf = rconvbuf;
+			inbufpos += *len;
+			iostats.replaced_in += *len;
+			return true;
+		}
+
+		inplen = avail < CONVCHUNKSZE ? avail : CONVCHUNKSZE;
+		if (charset_is != NULL) {
+			/* single-byte, so there are no truncated sequences to
+			 * worry about, and output always fits in rconvbuf */
+			*buf = rconvbuf;
+			*len = charset_decode(charset_is, inbuf + inbufpos,
+					inplen, rconvbuf, &iostats.replaced_in);
+			inbufpos += inplen;
+			return true;
 		}
 
-		readbuflen += readbufpos;
-		readbufpos = 0;
-		rutf8buflen = rutf8bufsze;
-		/* iconv updates readbuflen and utf8buflen */
+		outlen = rconvbufsze;
+		procinp = (char *)inbuf + inbufpos;
+		procout = (char *)rconvbuf;
+		/* iconv updates inplen and outlen */
 		do {
-			iconvret = iconv(iconv_handle_is, &procinp, &readbuflen,
-					&procout, &rutf8buflen);
+			iconvret = iconv(iconv_handle_is, &procinp, &inplen,
+					&procout, &outlen);
 			if (iconvret == (size_t)-1) {
 				switch (errno) {
 					case EILSEQ:
 						/* byte is invalid, try to step over it */
 						*procout++ = '?';
 						procinp++;
-						readbuflen--;
-						rutf8buflen--;
+						inplen--;
+						outlen--;
+						iostats.replaced_in++;
 						break;
 					case EINVAL:
 						/* this typically means we stopped reading halfway,
-						 * e.g. this is fine, resume next time */
-						memmove(readbuf, procinp, readbuflen);
-						readbufpos = readbuflen;
+						 * e.g. this is fine, resume next time, if this
+						 * isn't the end of our chunk, we need more input */
+						if (procinp + inplen == (char *)inbuf + inbuflen)
+							needmore = true;
 						iconvret = 0;
 						break;
 					case E2BIG:
 						/* output buffer is not large enough, this is
 						 * impossible since we allocate 4x */
 					default:
+						return false;
+				}
+			}
+		} while (iconvret == (size_t)-1 && inplen > 0);
+		inbufpos = procinp - (char *)inbuf;
+		*buf = rconvbuf;
+		*len = procout - (char *)rconvbuf;
+
+		if (*len > 0)
+			return true;
+	}
+}
+
+/*
+ * Convert what is in writebuf into a buffer queued for output, returns
+ * EOF on conversion errors.  Unless "final" is set, a truncated
+ * multibyte sequence at the end is retained for the next round.
+ */
+int
+iconvstream::encode_os(bool final)
+{
+	size_t inplen = writebufpos;
+	unsigned char *outbuf;
+	size_t outlen;
+
+	if (inplen == 0)
+		return 0;
+
+	if (outfree.empty()) {
+		outbuf = new unsigned char[outbufsze];
+	} else {
+		outbuf = outfree.back();
+		outfree.pop_back();
+	}
+
+	if (utf8_sink) {
+		/* the formatter already produces UTF-8, so queue it as is
+		 * after replacing anything invalid in place, and continue in
+		 * a fresh buffer */
+		size_t keep = utf8_sanitize(writebuf, inplen, final);
+
+		memcpy(outbuf, writebuf + inplen - keep, keep);
+		writebufpos = keep;
+		outlen = inplen - keep;
+		std::swap(outbuf, writebuf);
+	} else if (translit_sink) {
+		size_t used;
+
+		outlen = charset_translit_ascii(writebuf, inplen, final,
+				outbuf, &used);
+		memmove(writebuf, writebuf + used, inplen - used);
+		writebufpos = inplen - used;
+	} else {
+		size_t iconvret;
+		size_t avail = outbufsze;
+		char *procinp = (char *)writebuf;
+		char *procout = (char *)outbuf;
+
+		writebufpos = 0;
+		do {
+			/* iconv updates inplen and avail */
+			iconvret = iconv(iconv_handle_os, &procinp, &inplen,
+					&procout, &avail);
+
+			if (iconvret == (size_t)-1) {
+				switch (errno) {
+					case EILSEQ:
+						/* byte is invalid, try to step over it,
+						 * this shouldn't happen for the input is
+						 * generated by iconv itself during input */
+						*procout++ = '?';
+						procinp++;
+						inplen--;
+						avail--;
+						break;
+					case EINVAL:
+						/* the only valid problem should be the end
+						 * of the input being truncated */
+						if (inplen < 4 && !final) {
+							/* shift this so a next attempt can
+							 * retry the completion */
+							memmove(writebuf, procinp, inplen);
+							writebufpos = inplen;
+							iconvret = 0;
+							break;
+						}
+						/* fall through */
+					case E2BIG:
+						/* output buffer is not large enough, this is
+						 * impossible since we allocate 4x */
+					default:
+						outfree.push_back(outbuf);
 						return EOF;
 				}
 			}
 		} while (iconvret == (size_t)-1);
-		rutf8bufpos = 0;
-		rutf8buflen = procout - (char *)rutf8buf;
+		outlen = procout - (char *)outbuf;
 	}
 
-	return rutf8bufpos < rutf8buflen ? rutf8buf[rutf8bufpos++] : EOF;
+	if (outlen == 0) {
+		outfree.push_back(outbuf);
+	} else {
+		struct iovec iov;
+
+		iov.iov_base = outbuf;
+		iov.iov_len = outlen;
+		outiov.push_back(iov);
+		outbufs.push_back(outbuf);
+		outiovlen += outlen;
+	}
+
+	return 0;
+}
+
+/*
+ * Write all queued output buffers with as few writev() calls as
+ * possible, returns -1 on error.
+ */
+int
+iconvstream::write_os()
+{
+	size_t first = 0;
+	int ret = 0;
+
+	while (first < outiov.size()) {
+		size_t cnt = outiov.size() - first;
+		ssize_t r;
+
+		if (cnt > OUTIOVMAX)
+			cnt = OUTIOVMAX;
+		r = ::writev(fd_os, &outiov[first], cnt);
+		iostats.write_calls++;
+		if (r < 0) {
+			if (errno == EINTR)
+				continue;
+			ret = -1;
+			break;
+		}
+		iostats.bytes_out += r;
+		/* skip what was written, partial writes continue where they
+		 * stopped */
+		while (r > 0) {
+			if ((size_t)r < outiov[first].iov_len) {
+				outiov[first].iov_base =
+					(char *)outiov[first].iov_base + r;
+				outiov[first].iov_len -= r;
+				break;
+			}
+			r -= outiov[first].iov_len;
+			first++;
+		}
+	}
+
+	/* on errors the output is lost, there is nothing better to do */
+	outfree.insert(outfree.end(), outbufs.begin(), outbufs.end());
+	outbufs.clear();
+	outiov.clear();
+	outiovlen = 0;
+
+	return ret;
 }
 
 int
@@ -273,7 +877,7 @@ iconvstream::write(const char *inp, size_t len)
 	size_t outlen = len;
 	size_t copylen;
 	size_t copypos = 0;
-	int ret = -1;
+	bool dowrite;
 
 	do {
 		copylen = writebufsze - writebufpos;
@@ -284,59 +888,28 @@ iconvstream::write(const char *inp, size_t len)
 		copypos += copylen;
 		writebufpos += copylen;
 
-		/* flush if the buffer is full, or when explicitly requested */
-		if (writebufpos == writebufsze || len == 0) {
-			size_t iconvret;
-			size_t inplen = writebufpos;
-			char *procinp = (char *)writebuf;
-			char *procout = (char *)wutf8buf;
-			writebufpos = 0;
-
-			wutf8buflen = wutf8bufsze;
-			do {
-				/* iconv updates len and writebuflen */
-				iconvret = iconv(iconv_handle_os, &procinp, &inplen,
-						&procout, &wutf8buflen);
-
-				if (iconvret == (size_t)-1) {
-					switch (errno) {
-						case EILSEQ:
-							/* byte is invalid, try to step over it,
-							 * this shouldn't happen for the input is
-							 * generated by iconv itself during input */
-							*procout++ = '?';
-							procinp++;
-							inplen--;
-							wutf8buflen--;
-							break;
-						case EINVAL:
-							/* the only valid problem should be the end
-							 * of the input being truncated */
-							if (inplen < 4 && len != 0) {
-								/* shift this so a next attempt can
-								 * retry the completion */
-								memmove(writebuf, procinp, inplen);
-								writebufpos = inplen;
-								iconvret = 0;
-								break;
-							}
-							/* fall through */
-						case E2BIG:
-							/* output buffer is not large enough, this is
-							 * impossible since we allocate 4x */
-						default:
-							return EOF;
-					}
-				}
-			} while (iconvret == (size_t)-1);
-
-			ret = ::write(fd_os, wutf8buf, procout - (char *)wutf8buf);
-		} else {
-			ret = len;
+		switch (flush_policy) {
+			case FLUSH_BLOCK:
+				dowrite = len == 0;
+				break;
+			case FLUSH_SIZE:
+				dowrite = outiovlen + writebufpos >= flush_size;
+				break;
+			default:
+				dowrite = false;
+				break;
+		}
+		if (writebufpos == writebufsze || dowrite) {
+			if (encode_os(false) == EOF)
+				return EOF;
+		}
+		if (dowrite && outiovlen > 0) {
+			if (write_os() == -1)
+				return EOF;
 		}
 	} while (outlen > 0);
 
-	return ret;
+	return len;
 }
 
 iconvstream &iconvstream::operator<<(const char *inp)
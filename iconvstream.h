@@ -17,10 +17,16 @@
 
 #include <fstream>
 #include <string>
+#include <cstring>
+#include <vector>
 #include <unistd.h>
+#include <sys/uio.h>
 #include <iconv.h>
+#include <pthread.h>
+#include <semaphore.h>
 
 using std::string;
+using std::vector;
 
 const char endl = '\n';
 const char flush = '\0';
@@ -30,19 +36,78 @@ class iconvstream {
 		iconvstream():
 			open_err(0),
 			fd_is(-1),
-			fd_os(-1)
+			iconv_handle_is(iconv_t(-1)),
+			fd_os(-1),
+			flush_policy(FLUSH_AUTO),
+			flush_size(0)
 		{
+			memset(&iostats, 0, sizeof(iostats));
+			readbuf = NULL;
+			readbufsze = 0;
+			rconvbuf = NULL;
+			rconvbufsze = 0;
+			iconv_cache_next = 0;
+			readahead = false;
+			readahead_running = false;
+			push_is = false;
+			memset(readahead_slots, 0, sizeof(readahead_slots));
 		}
+		~iconvstream();
+
+		/*
+		 * When output is written, FLUSH_BLOCK writes on every flush,
+		 * FLUSH_SIZE once at least flush_size bytes are pending, and
+		 * FLUSH_NEVER only when the stream is closed.  FLUSH_AUTO
+		 * picks FLUSH_BLOCK for terminals, FLUSH_SIZE otherwise.
+		 */
+		enum { FLUSH_AUTO, FLUSH_NEVER, FLUSH_BLOCK, FLUSH_SIZE };
+		struct stats {
+			size_t read_calls;
+			size_t bytes_in;
+			size_t replaced_in;  /* invalid input bytes */
+			size_t write_calls;
+			size_t bytes_out;
+		};
 
 		void open_is(const char *url, const char *encoding);
 		void open_is(const string &url, const char *encoding);
+		/*
+		 * Rather than reading input, take what is given to push(),
+		 * until push_eof().  Only the scanner handles running out of
+		 * such input, see HTMLControl::NEED_INPUT.
+		 */
+		void open_push(const char *encoding);
+		void push(const void *buf, size_t len);
+		void push_eof(void);
 		void close_is(void);
 		void open_os(const char *url, const char *encoding);
 		void open_os(const string &url, const char *encoding);
 		void close_os(void);
+		void set_flush_policy(int policy, size_t size = 0);
+		/*
+		 * Decode input that is not a regular file (pipes, sockets) in
+		 * a separate thread, so reading and decoding overlap with the
+		 * parsing and rendering of what came before.
+		 */
+		void set_readahead(bool enable)
+		{
+			readahead = enable;
+		}
+		const struct stats &get_stats() const
+		{
+			return iostats;
+		}
 		int is_open() const
 		{
-			return fd_is >= 0;
+			return fd_is >= 0 || push_is;
+		}
+		/*
+		 * Whether get() or span() came up empty because all pushed
+		 * input is consumed, rather than because of EOF.
+		 */
+		bool starved() const
+		{
+			return push_is && !inbufeof && open_err == 0;
 		}
 		int os_open() const
 		{
@@ -54,37 +119,140 @@ class iconvstream {
 			close_os();
 		}
 		const char *open_error_msg() const;
-		int get();
+		/*
+		 * The encoding the input is decoded from, which is only known
+		 * for sure once input was read, until then it may be "auto".
+		 */
+		const char *input_encoding() const
+		{
+			return encoding;
+		}
+		int get()
+		{
+			if (rutf8bufpos == rutf8buflen && !underflow())
+				return EOF;
+			return rutf8buf[rutf8bufpos++];
+		}
+		/*
+		 * Bulk access to the decoded input: returns the number of UTF-8
+		 * bytes available at *buf, which is refilled once all of it is
+		 * consumed, 0 means EOF, or that pushed input ran out.  A span
+		 * never ends halfway through a character.  Tell with consume()
+		 * how much of it was used.
+		 */
+		size_t span(const unsigned char **buf)
+		{
+			if (rutf8bufpos == rutf8buflen && !underflow())
+				return 0;
+			*buf = rutf8buf + rutf8bufpos;
+			return rutf8buflen - rutf8bufpos;
+		}
+		void consume(size_t len)
+		{
+			rutf8bufpos += len;
+		}
+		/*
+		 * Whether the span at buf stays valid until the input is
+		 * closed, rather than until the next span, which is the case
+		 * for UTF-8 taken straight from an mmap-ed file.
+		 */
+		bool span_retained(const unsigned char *buf) const
+		{
+			return mapbuf != NULL &&
+				buf >= mapbuf && buf < mapbuf + mapbufsze;
+		}
 		int write(const char *inp, size_t len);
 		iconvstream &operator<<(const char *inp);
 		iconvstream &operator<<(const string &inp);
 		iconvstream &operator<<(char inp);
 
 	private:
+		void reset_is(void);
+		bool underflow();
+		bool setup_is();
+		bool decode(const unsigned char **buf, size_t *len);
+		static void *readahead_main(void *arg);
+		void readahead_run();
+		bool fill_is();
+		iconv_t iconv_get(const char *encoding);
+		int encode_os(bool final);
+		int write_os();
+
 		const char *open_err;
 		const char *encoding;
 
 		int fd_is;
+		bool push_is;
 		iconv_t iconv_handle_is;
+		/* setting up iconv is expensive, so for multiple documents in
+		 * the same charset its descriptors are reused */
+		struct {
+			string encoding;
+			iconv_t cd;
+		} iconv_cache[4];
+		size_t iconv_cache_next;
+		char sniffed_encoding[128];
+		/* input bytes are either taken from an mmap-ed regular file, or
+		 * read() into readbuf, which grows for pipes that keep it full,
+		 * readbuf and rconvbuf are kept for the next document */
+		unsigned char *mapbuf;
+		size_t mapbufsze;
 		unsigned char *readbuf;
 		size_t readbufsze;
-		size_t readbuflen;
-		size_t readbufpos;
-		unsigned char *rutf8buf;
-		size_t rutf8bufsze;
+		bool readbufgrow;
+		unsigned char *inbuf;
+		size_t inbuflen;
+		size_t inbufpos;
+		bool inbufeof;
+		/* decoded UTF-8 handed out by get(), this points either into
+		 * rconvbuf, or straight into inbuf when the input needs no
+		 * conversion, charset_is is set for input that we decode
+		 * ourselves instead of using iconv */
+		bool utf8_passthrough;
+		const struct charset *charset_is;
+		const unsigned char *rutf8buf;
 		size_t rutf8buflen;
 		size_t rutf8bufpos;
+		unsigned char *rconvbuf;
+		size_t rconvbufsze;
+		/* with read-ahead, a thread decodes into a ring of slots, which
+		 * underflow() takes from readahead_filled in order, and gives
+		 * back through readahead_free once get() went past them, only
+		 * the thread touches the input fields above then */
+		bool readahead;
+		bool readahead_running;
+		pthread_t readahead_thread;
+		sem_t readahead_filled;
+		sem_t readahead_free;
+		struct readahead_slot {
+			unsigned char *buf;
+			size_t len;
+		} readahead_slots[4];
+		size_t readahead_prod;
+		size_t readahead_cons;
+		bool readahead_holding;
+		bool readahead_eof;
 
 		int fd_os;
+		bool utf8_sink;
+		bool translit_sink;
 		iconv_t iconv_handle_os;
+		int flush_policy;
+		size_t flush_size;
+		/* UTF-8 written to us is collected in writebuf, and converted
+		 * into buffers of outbufsze when it is full or output is due,
+		 * these are queued in outiov until they are written, after
+		 * which they are kept in outfree for reuse */
 		unsigned char *writebuf;
 		size_t writebufsze;
-		size_t writebuflen;
 		size_t writebufpos;
-		unsigned char *wutf8buf;
-		size_t wutf8bufsze;
-		size_t wutf8buflen;
-		size_t wutf8bufpos;
+		size_t outbufsze;
+		vector<struct iovec> outiov;
+		vector<unsigned char *> outbufs;
+		size_t outiovlen;
+		vector<unsigned char *> outfree;
+
+		struct stats iostats;
 };
 
 #endif
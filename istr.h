@@ -78,6 +78,29 @@ class istr {
 			elems.insert(elems.begin() + pos, i);
 			return *this;
 		}
+		/* replace every run of whitespace by a single space, in one
+		 * pass over the string */
+		istr &collapse_space(void)
+		{
+			size_t len = 0;
+			bool inspace = false;
+
+			for (size_t i = 0; i < elems.size(); i++) {
+				int c = elems[i];
+
+				if (isspace(c)) {
+					if (inspace)
+						continue;
+					inspace = true;
+					c = ' ';
+				} else {
+					inspace = false;
+				}
+				elems[len++] = c;
+			}
+			elems.resize(len);
+			return *this;
+		}
 		istr slice(size_t pos = 0, size_t len = string::npos)
 		{
 			istr ret = istr();
@@ -111,6 +134,33 @@ class istr {
 			elems.push_back(inp);
 			return *this;
 		}
+		/* add the UTF-8 in p, one character per element */
+		istr &append(const unsigned char *p, size_t len)
+		{
+			const unsigned char *end = p + len;
+
+			while (p < end) {
+				const unsigned char *q;
+				unsigned int c;
+
+				for (q = p; q < end && *q < 0x80; q++)
+					;
+				elems.insert(elems.end(), p, q);
+				if (q == end)
+					break;
+
+				/* pack a multibyte character lead byte first, the way
+				 * c_str() unpacks it */
+				c = *q++;
+				for (unsigned char point = 1;
+						(c >> (7 - point)) & 1 && point < 4 && q < end;
+						point++)
+					c |= (unsigned int)*q++ << (8 * point);
+				elems.push_back((int)c);
+				p = q;
+			}
+			return *this;
+		}
 		istr &operator+=(const char *p)
 		{
 			for (; *p != '\0'; p++)
@@ -159,10 +209,12 @@ class istr {
 		{
 			return !(*this == inp);
 		}
+		/* the result is valid until the next call to c_str() */
 		const char *c_str(void) const
 		{
-			std::unique_ptr<string> s(new std::string);
+			string *s = &cstr;
 
+			s->clear();
 			for (int c : elems) {
 				*s += c & 0xFF;
 				if ((c >> 7) & 1) {
@@ -177,9 +229,16 @@ class istr {
 
 			return s->c_str();
 		}
+		/* the same as c_str(), with its length */
+		const string &str(void) const
+		{
+			c_str();
+			return cstr;
+		}
 
 	private:
 		std::vector<int> elems;
+		mutable string cstr;
 };
 
 #endif
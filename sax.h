@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#ifndef SAX_H
+#define SAX_H 1
+
+#include <cstddef>
+
+/*
+ * An attribute of a tag as it is in the input: the name as written,
+ * and the value without quotes, with entities left alone.  Both are
+ * UTF-8, and not NUL-terminated.
+ */
+struct SaxAttribute {
+	const char *name;
+	size_t namelen;
+	const char *value;
+	size_t valuelen;
+};
+
+/*
+ * Receives what HTMLControl::parse_events() finds in the input, in the
+ * order it is in there, without building a document from it.  All
+ * strings are borrowed from the scanner, and only valid during the
+ * call.  Text has its entities decoded, but is otherwise untouched,
+ * whitespace included.  The content of SCRIPT and STYLE is reported as
+ * text, and their end tag with the name in upper case.  Tags are
+ * reported whether html2text knows them or not, malformed markup is
+ * skipped.  A handler that has seen enough sets stop, after which no
+ * more input is scanned.
+ */
+class SaxHandler {
+	public:
+		SaxHandler():
+			stop(false)
+		{
+		}
+		virtual ~SaxHandler() {}
+
+		/* tag names are as written, attrs holds nattrs attributes */
+		virtual void start_tag(const char *, size_t,
+				const SaxAttribute *, size_t)
+		{
+		}
+		virtual void end_tag(const char *, size_t)
+		{
+		}
+		virtual void text(const char *, size_t)
+		{
+		}
+		virtual void comment(const char *, size_t)
+		{
+		}
+
+		bool stop;
+};
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define SCAN_X86 1
+# include <immintrin.h>
+#endif
+
+#include "scan.h"
+
+#ifdef SCAN_X86
+static bool
+scan_has_avx2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+}
+
+static inline bool
+scan_use_avx2(void)
+{
+	/* set on the first call, which C++11 makes thread-safe */
+	static const bool use_avx2 = scan_has_avx2();
+
+	return use_avx2;
+}
+#endif
+
+static inline unsigned char
+scan_fold(unsigned char c)
+{
+	return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+}
+
+/*
+ * Compare len bytes, folding case when asked to.
+ */
+static inline bool
+scan_equal(const unsigned char *p, const char *needle, size_t len,
+		bool nocase)
+{
+	size_t i;
+
+	if (!nocase)
+		return memcmp(p, needle, len) == 0;
+	for (i = 0; i < len; i++) {
+		if (scan_fold(p[i]) != scan_fold((unsigned char)needle[i]))
+			return false;
+	}
+	return true;
+}
+
+static const unsigned char *
+scan_find_scalar(const unsigned char *p, const unsigned char *end,
+		const char *needle, size_t len, bool nocase)
+{
+	unsigned char first = (unsigned char)needle[0];
+
+	/* most needles start with punctuation, so memchr can be used */
+	if (!nocase || !isalpha(first)) {
+		while (end - p >= (ptrdiff_t)len &&
+				(p = (const unsigned char *)memchr(p, first,
+					end - p - len + 1)) != NULL)
+		{
+			if (scan_equal(p, needle, len, nocase))
+				return p;
+			p++;
+		}
+		return NULL;
+	}
+
+	for (; end - p >= (ptrdiff_t)len; p++) {
+		if (scan_equal(p, needle, len, nocase))
+			return p;
+	}
+	return NULL;
+}
+
+static const unsigned char *
+scan_text_scalar(const unsigned char *p, const unsigned char *end)
+{
+	for (; p < end; p++) {
+		if (*p == '<' || *p == '&' || *p == '\n')
+			break;
+	}
+	return p;
+}
+
+#ifdef SCAN_X86
+# ifdef __SSE2__
+static const unsigned char *
+scan_text_sse2(const unsigned char *p, const unsigned char *end)
+{
+	const __m128i lt = _mm_set1_epi8('<');
+	const __m128i amp = _mm_set1_epi8('&');
+	const __m128i nl = _mm_set1_epi8('\n');
+
+	while (end - p >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)p);
+		int mask = _mm_movemask_epi8(_mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, lt),
+						_mm_cmpeq_epi8(v, amp)),
+					_mm_cmpeq_epi8(v, nl)));
+		if (mask != 0)
+			return p + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	return scan_text_scalar(p, end);
+}
+# endif
+
+__attribute__((target("avx2")))
+static const unsigned char *
+scan_text_avx2(const unsigned char *p, const unsigned char *end)
+{
+	const __m256i lt = _mm256_set1_epi8('<');
+	const __m256i amp = _mm256_set1_epi8('&');
+	const __m256i nl = _mm256_set1_epi8('\n');
+
+	while (end - p >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)p);
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+				_mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, lt),
+						_mm256_cmpeq_epi8(v, amp)),
+					_mm256_cmpeq_epi8(v, nl)));
+		if (mask != 0)
+			return p + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	return scan_text_scalar(p, end);
+}
+#endif
+
+#ifdef SCAN_X86
+/*
+ * For letters, setting 0x20 makes both cases equal, which for other
+ * bytes may give false candidates, scan_equal() weeds those out.
+ */
+# ifdef __SSE2__
+static const unsigned char *
+scan_find_sse2(const unsigned char *p, const unsigned char *end,
+		const char *needle, size_t len, bool nocase)
+{
+	unsigned char f = (unsigned char)needle[0];
+	unsigned char l = (unsigned char)needle[len - 1];
+	const __m128i ffold = _mm_set1_epi8(nocase && isalpha(f) ? 0x20 : 0);
+	const __m128i lfold = _mm_set1_epi8(nocase && isalpha(l) ? 0x20 : 0);
+	const __m128i first = _mm_or_si128(_mm_set1_epi8(f), ffold);
+	const __m128i last = _mm_or_si128(_mm_set1_epi8(l), lfold);
+
+	while (end - p >= (ptrdiff_t)(len - 1 + 16)) {
+		__m128i vf = _mm_loadu_si128((const __m128i *)p);
+		__m128i vl = _mm_loadu_si128((const __m128i *)(p + len - 1));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+					_mm_cmpeq_epi8(_mm_or_si128(vf, ffold), first),
+					_mm_cmpeq_epi8(_mm_or_si128(vl, lfold), last)));
+
+		while (mask != 0) {
+			const unsigned char *c = p + __builtin_ctz(mask);
+			if (scan_equal(c, needle, len, nocase))
+				return c;
+			mask &= mask - 1;
+		}
+		p += 16;
+	}
+
+	return scan_find_scalar(p, end, needle, len, nocase);
+}
+# endif
+
+__attribute__((target("avx2")))
+static const unsigned char *
+scan_find_avx2(const unsigned char *p, const unsigned char *end,
+		const char *needle, size_t len, bool nocase)
+{
+	unsigned char f = (unsigned char)needle[0];
+	unsigned char l = (unsigned char)needle[len - 1];
+	const __m256i ffold = _mm256_set1_epi8(nocase && isalpha(f) ? 0x20 : 0);
+	const __m256i lfold = _mm256_set1_epi8(nocase && isalpha(l) ? 0x20 : 0);
+	const __m256i first = _mm256_or_si256(_mm256_set1_epi8(f), ffold);
+	const __m256i last = _mm256_or_si256(_mm256_set1_epi8(l), lfold);
+
+	while (end - p >= (ptrdiff_t)(len - 1 + 32)) {
+		__m256i vf = _mm256_loadu_si256((const __m256i *)p);
+		__m256i vl = _mm256_loadu_si256((const __m256i *)(p + len - 1));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+				_mm256_and_si256(
+					_mm256_cmpeq_epi8(_mm256_or_si256(vf, ffold), first),
+					_mm256_cmpeq_epi8(_mm256_or_si256(vl, lfold), last)));
+
+		while (mask != 0) {
+			const unsigned char *c = p + __builtin_ctz(mask);
+			if (scan_equal(c, needle, len, nocase))
+				return c;
+			mask &= mask - 1;
+		}
+		p += 32;
+	}
+
+	return scan_find_scalar(p, end, needle, len, nocase);
+}
+#endif
+
+const unsigned char *
+scan_text(const unsigned char *p, const unsigned char *end)
+{
+#ifdef SCAN_X86
+	if (scan_use_avx2())
+		return scan_text_avx2(p, end);
+# ifdef __SSE2__
+	return scan_text_sse2(p, end);
+# endif
+#endif
+
+	return scan_text_scalar(p, end);
+}
+
+const unsigned char *
+scan_find(const unsigned char *p, const unsigned char *end,
+		const char *needle, size_t len, bool nocase)
+{
+#ifdef SCAN_X86
+	if (scan_use_avx2())
+		return scan_find_avx2(p, end, needle, len, nocase);
+# ifdef __SSE2__
+	return scan_find_sse2(p, end, needle, len, nocase);
+# endif
+#endif
+
+	return scan_find_scalar(p, end, needle, len, nocase);
+}
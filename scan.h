@@ -0,0 +1,41 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#ifndef SCAN_H
+#define SCAN_H 1
+
+#include <stddef.h>
+
+/*
+ * Return a pointer to the first '<', '&' or '\n' in the range from p
+ * up to end, or end if there is none, which are the bytes the scanner
+ * needs to look at in text.
+ * Depending on the CPU, this uses AVX2 or SSE2 to check 32 or 16 bytes
+ * at a time.
+ */
+extern const unsigned char *scan_text(const unsigned char *p,
+		const unsigned char *end);
+
+/*
+ * Return a pointer to the first occurrence of the len bytes of needle
+ * in the range from p up to end, or NULL if there is none.  With
+ * nocase, ASCII letters match regardless of their case.
+ * Candidates are found by comparing the first and last byte of needle
+ * 32 or 16 positions at a time, like scan_text does.
+ */
+extern const unsigned char *scan_find(const unsigned char *p,
+		const unsigned char *end, const char *needle, size_t len,
+		bool nocase);
+
+#endif
@@ -16,6 +16,7 @@
  * GNU General Public License in the file COPYING for more details.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
@@ -324,103 +325,108 @@ int mkutf8(unsigned long x)
 	return ret;
 }
 
-void
-replace_sgml_entities(istr *s)
+/*
+ * Skip the UTF-8 character at p.
+ */
+static const unsigned char *
+next_char(const unsigned char *p, const unsigned char *end)
 {
-	string::size_type j = 0;
+	for (p++; p < end && (*p & 0xC0) == 0x80; p++)
+		;
+	return p;
+}
 
-	for (;;) {
-		string::size_type l = s->length();
-		char c;
+size_t
+decode_sgml_entity(const unsigned char *p, const unsigned char *end,
+		bool eof, int *c)
+{
+	const unsigned char *q = p + 1;
+	int x = 0;
 
-		/* Skip characters before ampersand. */
-		while (j < l && (*s)[j] != '&')
-			j++;
+	*c = EOF;
+	if (*q == '#') {
+		/* Decode entities like "&#233;".
+		 * Some authors forget the ";", but we tolerate this. */
+		q++;
+		/* past the last code point, the digits are only skipped,
+		 * such that x cannot overflow */
+		if (isdigit(*q)) {
+			for (; q < end && isdigit(*q); q++)
+				if (x <= 0x10FFFF)
+					x = 10 * x + *q - '0';
+		} else if (*q == 'x' || *q == 'X') {  /* HTML Hex Entity */
+			for (q++; q < end && isxdigit(*q); q++)
+				if (x <= 0x10FFFF)
+					x = 16 * x +
+						(isdigit(*q) ? *q - '0' : tolower(*q) - 'a' + 10);
+		} else {
+			return next_char(q, end) - p;
+		}
+		if (q == end && !eof)
+			return 0;
+		if (q < end && *q == ';')
+			q++;
+		/* not a character, make it the replacement character */
+		if (x > 0x10FFFF || (x >= 0xD800 && x <= 0xDFFF))
+			x = 0xFFFD;
+		*c = mkutf8(x);
+	} else if (isalpha(*q)) {
+		/* Decode entities like "&nbsp;".
+		 * Some authors forget the ";", but we tolerate this. */
+		char name[NAME_BUF_SIZE];
+		size_t i = 0;
+		for (; q < end && isalnum(*q); q++) {
+			if (i < sizeof(name) - 1)
+				name[i++] = *q;
+		}
+		if (q == end && !eof)
+			return 0;
+		if (q < end && *q == ';')
+			q++;
+		name[i] = '\0';
 
-		if (j >= l)
-			break;
+		const TextToInt *entity = (const TextToInt *) bsearch(
+				name, entities, nelems(entities), sizeof(TextToInt),
+				(int (*)(const void *, const void *))strcmp);
+		if (entity != NULL && entity->unicode)
+			*c = mkutf8(entity->unicode);
+	} else {
+		/* EXTENSION: Allow literal '&' sometimes. */
+		q = next_char(q, end);
+	}
+
+	return q - p;
+}
+
+void
+replace_sgml_entities(istr *s)
+{
+	string b(s->c_str());
+	const unsigned char *p = (const unsigned char *)b.data();
+	const unsigned char *end = p + b.length();
+	const unsigned char *q = p;
+	istr ret;
 
-		/*
-		 * So we have an ampersand...
-		 */
+	while ((q = (const unsigned char *)memchr(q, '&', end - q)) != NULL) {
+		const unsigned char *r = q;
+		int n;
+		int c;
 
 		/* Don't process the last three characters; an SGML entity
 		 * wouldn't fit in anyway! */
-		if (j + 3 >= l)
+		for (n = 0; n < 4 && r < end; n++)
+			r = next_char(r, end);
+		if (n < 4)
 			break;
 
-		string::size_type beg = j++; // Skip the ampersand;
-
-		/* Look at the next character. */
-		c = (*s)[j++];
-		if (c == '#') {
-			/* Decode entities like "&#233;".
-			 * Some authors forget the ";", but we tolerate this. */
-			c = (*s)[j++];
-			if (isdigit(c)) {
-				int x = c - '0';
-				for (; j < l; j++) {
-					c = (*s)[j];
-					if (c == ';') {
-						j++;
-						break;
-					}
-					if (!isdigit(c))
-						break;
-					x = 10 * x + c - '0';
-				}
-				s->replace(beg, j - beg, mkutf8(x));
-				j = beg + 1;
-			} else if (c == 'x' || c == 'X') {  /* HTML Hex Entity */
-				int x = 0;
-				int v;
-				for (; j < l; j++) {
-					c = tolower((*s)[j]);
-					if (c == ';') {
-						j++;
-						break;
-					}
-					if (isdigit(c)) {
-						v = c - '0';
-					} else if (c >= 'a' && c <= 'f') {
-						v = 10 + c - 'a';
-					} else {
-						break;
-					}
-					x = 16 * x + v;
-				}
-				s->replace(beg, j - beg, mkutf8(x));
-				j = beg + 1;
-			}
-		} else if (isalpha(c)) {
-			/* Decode entities like "&nbsp;".
-			 * Some authors forget the ";", but we tolerate this. */
-			char name[NAME_BUF_SIZE];
-			name[0] = c;
-			size_t i = 1;
-			for (; j < l; ++j) {
-				c = (*s)[j];
-				if (c == ';') {
-					++j;
-					break;
-				}
-				if (!isalnum(c))
-					break;
-				if (i < sizeof(name) - 1)
-					name[i++] = c;
-			}
-			name[i] = '\0';
-
-			const TextToInt *entity = (const TextToInt *) bsearch(
-					name, entities, nelems(entities), sizeof(TextToInt),
-					(int (*)(const void *, const void *))strcmp);
-			if (entity != NULL) {
-				if (entity->unicode)
-					s->replace(beg, j - beg, mkutf8(entity->unicode));
-				j = beg + 1;
-			}
-		} else {
-			;                   /* EXTENSION: Allow literal '&' sometimes. */
+		r = q + decode_sgml_entity(q, end, true, &c);
+		if (c != EOF) {
+			ret.append(p, q - p);
+			ret += c;
+			p = r;
 		}
+		q = r;
 	}
+	ret.append(p, end - p);
+	*s = ret;
 }
@@ -26,4 +26,14 @@
  */
 extern void replace_sgml_entities(istr *s);
 
+/*
+ * Decode the entity in the UTF-8 at p, which points to a '&' followed by
+ * at least three more characters, looking no further than end.  Returns
+ * the number of bytes it takes, with its character in *c, or with EOF in
+ * *c when those bytes are to be taken literally.  Returns 0 when end cuts
+ * the entity short, and more input may follow unless eof is set.
+ */
+extern size_t decode_sgml_entity(const unsigned char *p,
+		const unsigned char *end, bool eof, int *c);
+
 #endif /* } */
@@ -99,10 +99,10 @@ create_lcs(
 
 		const TableRow &row(**ri);
 
-		istr style = get_attribute(row.attributes.get(), "STYLE", "");
+		istr style = get_attribute(row.attributes.get(), ATTR_STYLE, "");
 
 		int row_halign = get_attribute(
-				row.attributes.get(), "ALIGN", -1,
+				row.attributes.get(), ATTR_ALIGN, -1,
 				"LEFT", Area::LEFT,
 				"CENTER", Area::CENTER,
 				"RIGHT", Area::RIGHT,
@@ -118,7 +118,7 @@ create_lcs(
 				row_halign = Area::LEFT;
 		}
 		int row_valign = get_attribute(
-				row.attributes.get(), "VALIGN", -1,
+				row.attributes.get(), ATTR_VALIGN, -1,
 				"TOP", Area::TOP,
 				"MIDDLE", Area::MIDDLE,
 				"BOTTOM", Area::BOTTOM,
@@ -146,8 +146,8 @@ create_lcs(
 			p->cell = &cell;
 			p->x = x;
 			p->y = y;
-			p->w = get_attribute(cell.attributes.get(), "COLSPAN", 1);
-			p->h = get_attribute(cell.attributes.get(), "ROWSPAN", 1);
+			p->w = get_attribute(cell.attributes.get(), ATTR_COLSPAN, 1);
+			p->h = get_attribute(cell.attributes.get(), ATTR_ROWSPAN, 1);
 			if (p->w < 1)
 				p->w = 1;
 			if (p->h < 1)
@@ -156,10 +156,10 @@ create_lcs(
 				*number_of_columns_return = x + p->w;
 			if (y + p->h > *number_of_rows_return)
 				*number_of_rows_return = y + p->h;
-			istr style = get_attribute(cell.attributes.get(), "STYLE", "");
+			istr style = get_attribute(cell.attributes.get(), ATTR_STYLE, "");
 
 			p->halign = get_attribute(
-					cell.attributes.get(), "ALIGN", -1,
+					cell.attributes.get(), ATTR_ALIGN, -1,
 					"LEFT", Area::LEFT,
 					"CENTER", Area::CENTER,
 					"RIGHT", Area::RIGHT,
@@ -177,7 +177,7 @@ create_lcs(
 					p->halign = row_halign;
 			}
 			p->valign = get_attribute(
-					cell.attributes.get(), "VALIGN", -1,
+					cell.attributes.get(), ATTR_VALIGN, -1,
 					"TOP", Area::TOP,
 					"MIDDLE", Area::MIDDLE,
 					"BOTTOM", Area::BOTTOM,
@@ -413,14 +413,14 @@ Area *
 Table::format(Area::size_type w, int halign) const
 {
 	int ahalign = get_attribute(
-			attributes.get(), "ALIGN", -1,
+			attributes.get(), ATTR_ALIGN, -1,
 			"LEFT", Area::LEFT,
 			"CENTER", Area::CENTER,
 			"RIGHT", Area::RIGHT,
 			NULL
 			);
 	if (ahalign == -1) {
-		istr style = get_attribute(attributes.get(), "STYLE", "");
+		istr style = get_attribute(attributes.get(), ATTR_STYLE, "");
 		istr align = get_style_attr(&style, "text-align", "");
 
 		if (align.compare(0, 5, "left") == 0)
@@ -437,7 +437,7 @@ Table::format(Area::size_type w, int halign) const
 	// <TABLE BORDER>   => ""      => draw border
 	// <TABLE BORDER=0> => "0"     => no border
 	// <TABLE BORDER=1> => "1"     => draw border
-	bool draw_border = get_attribute(attributes.get(), "BORDER", "0") != "0";
+	bool draw_border = get_attribute(attributes.get(), ATTR_BORDER, "0") != "0";
 
 	static const Area::size_type column_spacing = 1;
 	static const Area::size_type row_spacing = 0;
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+/*
+ * Checks that the built-in single-byte decoders decode each of the 256
+ * bytes the same as iconv does, an undefined byte being a '?' in both.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <iconv.h>
+
+#include "../charsets.h"
+
+static const char *names[] = {
+	"ISO-8859-1",
+	"ISO-8859-2",
+	"ISO-8859-15",
+	"WINDOWS-1250",
+	"WINDOWS-1251",
+	"WINDOWS-1252",
+	"KOI8-R",
+};
+
+/* decode a single byte with iconv into out, returns its length */
+static size_t
+iconv_byte(iconv_t cd, unsigned char b, char *out, size_t outsze)
+{
+	char *inp = (char *)&b;
+	char *outp = out;
+	size_t inlen = 1;
+
+	iconv(cd, NULL, NULL, NULL, NULL);
+	if (iconv(cd, &inp, &inlen, &outp, &outsze) == (size_t)-1) {
+		if (errno != EILSEQ)
+			return 0;
+		*outp++ = '?';
+	}
+	return outp - out;
+}
+
+int
+main(void)
+{
+	int fails = 0;
+	int tsts = 0;
+
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		const struct charset *cs = charset_find(names[i]);
+		iconv_t cd;
+		int bad = 0;
+
+		tsts++;
+		if (cs == NULL) {
+			printf("test charset %s: FAIL (no built-in decoder)\n",
+					names[i]);
+			fails++;
+			continue;
+		}
+		cd = iconv_open("UTF-8", names[i]);
+		if (cd == iconv_t(-1)) {
+			printf("test charset %s: skipped, iconv doesn't know it\n",
+					names[i]);
+			continue;
+		}
+
+		for (unsigned int b = 0; b < 256; b++) {
+			unsigned char in = (unsigned char)b;
+			unsigned char got[4];
+			char want[8];
+			size_t replaced = 0;
+			size_t gotlen = charset_decode(cs, &in, 1, got, &replaced);
+			size_t wantlen = iconv_byte(cd, in, want, sizeof(want));
+
+			if (gotlen != wantlen || memcmp(got, want, gotlen) != 0 ||
+					(replaced != 0) != (want[0] == '?' && b != '?'))
+			{
+				printf("test charset %s: byte 0x%02X decodes wrong\n",
+						names[i], b);
+				bad++;
+			}
+		}
+		iconv_close(cd);
+
+		if (bad != 0) {
+			printf("test charset %s: FAIL\n", names[i]);
+			fails++;
+		}
+	}
+
+	printf("%d charset tests, %d success, %d failures\n",
+			tsts, tsts - fails, fails);
+
+	return fails != 0;
+}
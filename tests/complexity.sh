@@ -0,0 +1,150 @@
+#!/usr/bin/env bash
+
+# Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License in the file COPYING for more details.
+
+# Check that processing time grows linearly with the input, by timing
+# generated documents of a small and a four times larger size.  A
+# quadratic pass takes sixteen times as long on the larger one, so a
+# factor of eight leaves ample room for noise.  The time limit makes
+# sure a regression fails instead of hanging.
+
+H2T="../html2text -rcfile .html2textrc"
+SMALL=100000
+LIMIT=60
+
+tmpdir=$(mktemp -d "${TMPDIR:-/tmp}/h2t-complexity.XXXXXX") || exit 1
+trap 'rm -rf "${tmpdir}"' EXIT
+
+# one paragraph with a run of mixed whitespace after every word, which
+# is what whitespace collapsing has to deal with
+gen_whitespace() {
+	awk -v n=$1 'BEGIN {
+		printf "<html><body><p>";
+		for (i = 0; i < n; i++)
+			printf "word \t\n  ";
+		printf "</p></body></html>\n";
+	}'
+}
+
+# one paragraph dense with entities, which are decoded while scanning
+gen_entities() {
+	awk -v n=$1 'BEGIN {
+		printf "<html><body><p>";
+		for (i = 0; i < n; i++)
+			printf "&nbsp;&lt;x&#233;&amp;";
+		printf "</p></body></html>\n";
+	}'
+}
+
+# one tag with a name of 40 characters for every n
+gen_long_tag() {
+	awk -v n=$1 'BEGIN {
+		printf "<html><body><p>a<x";
+		for (i = 0; i < n; i++)
+			printf "abcdefghijklmnopqrstuvwxyzabcdefghijklmn";
+		printf ">b</p></body></html>\n";
+	}'
+}
+
+# one tag with an unquoted value of 40 characters for every n
+gen_long_attribute() {
+	awk -v n=$1 'BEGIN {
+		printf "<html><body><p>a<img alt=x src=";
+		for (i = 0; i < n; i++)
+			printf "abcdefghijklmnopqrstuvwxyzabcdefghijklmn";
+		printf ">b</p></body></html>\n";
+	}'
+}
+
+# a UTF-8 document of about n bytes, of which the HEAD is a tiny start
+gen_head() {
+	printf '<html><head><meta charset="utf-8"><title>t</title></head>\n'
+	printf '<body>\n'
+	yes $'<p>h\xc3\xa9llo w\xc3\xb6rld</p>' | head -c $1
+	printf '</body></html>\n'
+}
+
+# time the conversion of a file, with any further options, read from
+# a pipe when asked, which also takes it as ISO-8859-1, such that the
+# scanner gets it in many pieces that are copied
+time_h2t() {
+	local TIMEFORMAT=%R
+	local file=$1
+	local input=$2
+	shift 2
+	if [[ ${input} == pipe ]] ; then
+		{ time cat "${file}" | timeout ${LIMIT} ${H2T} \
+			-from_encoding iso-8859-1 "$@" > /dev/null 2>&1 ; } 2>&1
+	else
+		{ time timeout ${LIMIT} ${H2T} "$@" "${file}" \
+			> /dev/null 2>&1 ; } 2>&1
+	fi
+}
+
+fails=0
+sucs=0
+tsts=0
+# tags that continue past a piece must not be scanned again from the
+# start with every next piece
+for t in whitespace entities long_tag:pipe long_attribute:pipe ; do
+	input=file
+	if [[ ${t} == *:* ]] ; then
+		input=${t#*:}
+		t=${t%:*}
+	fi
+	gen_${t} ${SMALL} > "${tmpdir}/small.html"
+	gen_${t} $((SMALL * 4)) > "${tmpdir}/large.html"
+
+	small=$(time_h2t "${tmpdir}/small.html" ${input})
+	large=$(time_h2t "${tmpdir}/large.html" ${input})
+	[[ -n ${TEST_VERBOSE} ]] && \
+		echo "${t}: ${small}s for ${SMALL}, ${large}s for $((SMALL * 4))"
+
+	# the extra half second keeps start-up costs and timer resolution
+	# from tripping this up on fast machines
+	if awk -v s=${small} -v l=${large} -v m=${LIMIT} \
+		'BEGIN { exit !(l < m && l <= s * 8 + 0.5) }'
+	then
+		: $((sucs++))
+	else
+		echo "test complexity ${t}: FAIL (${small}s vs ${large}s)"
+		: $((fails++))
+	fi
+	: $((tsts++))
+done
+
+# -head reads no further than the HEAD, so it takes about as long on a
+# document of 128MiB as on one of 1MiB, the rest of a mapped file must
+# not even be validated as UTF-8
+gen_head $((1024 * 1024)) > "${tmpdir}/small.html"
+gen_head $((128 * 1024 * 1024)) > "${tmpdir}/large.html"
+small=$(time_h2t "${tmpdir}/small.html" file -head)
+large=$(time_h2t "${tmpdir}/large.html" file -head)
+rm -f "${tmpdir}/large.html"
+[[ -n ${TEST_VERBOSE} ]] && \
+	echo "head: ${small}s for 1MiB, ${large}s for 128MiB"
+if awk -v s=${small} -v l=${large} \
+	'BEGIN { exit !(l <= s * 2 + 0.03) }'
+then
+	: $((sucs++))
+else
+	echo "test complexity head: FAIL (${small}s vs ${large}s)"
+	: $((fails++))
+fi
+: $((tsts++))
+
+echo "${tsts} complexity tests, ${sucs} success, ${fails} failures"
+
+[[ ${fails} -ne 0 ]] && exit 1
+
+exit 0
@@ -0,0 +1,113 @@
+#!/usr/bin/env bash
+
+# Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License in the file COPYING for more details.
+
+# Check that the options which only change how input is read and output
+# is written leave the output alone: every variant below must print
+# exactly what the default run prints, reading the test from the file
+# as well as from a pipe.  -stats must also report what it counted.
+
+H2T="../html2text -rcfile .html2textrc"
+TESTS=( "$@" )
+VARIANTS=(
+	flush-block:"-flush block"
+	flush-never:"-flush never"
+	flush-size:"-flush 7"
+	readahead:"-readahead"
+	stats:"-stats"
+)
+
+tmpdir=$(mktemp -d "${TMPDIR:-/tmp}/h2t-options.XXXXXX") || exit 1
+trap 'rm -rf "${tmpdir}"' EXIT
+
+# print the first count of "what" on the stats line "line" in file:
+#   stat_of file line what
+stat_of() {
+	grep "^$2:" "$1" | grep -o "[0-9][0-9]* [a-z ]*$3" | \
+		head -n 1 | cut -d' ' -f1
+}
+
+fails=0
+sucs=0
+tsts=0
+for t in "${TESTS[@]}" ; do
+	t=${t%.html}  # allow easy globbing
+	if [[ ! -e ${t}.html ]] ; then
+		echo "skipping non-existent test: ${t}"
+		continue
+	fi
+
+	inpenc=${t%=*}
+	${H2T} -from_encoding ${inpenc} ${t}.html > "${tmpdir}/default" 2>&1
+	for variant in "${VARIANTS[@]}" ; do
+		vname=${variant%:*}
+		vargs=${variant#*:}
+		for input in file pipe ; do
+			[[ -n ${TEST_VERBOSE} ]] && \
+				echo ${H2T} -from_encoding ${inpenc} ${vargs} ${t}.html \
+					"(${input})"
+			if [[ ${input} == file ]] ; then
+				${H2T} -from_encoding ${inpenc} ${vargs} ${t}.html \
+					> "${tmpdir}/out" 2> "${tmpdir}/err"
+			else
+				cat ${t}.html | ${H2T} -from_encoding ${inpenc} ${vargs} \
+					> "${tmpdir}/out" 2> "${tmpdir}/err"
+			fi
+			ok=true
+			cmp -s "${tmpdir}/default" "${tmpdir}/out" || ok=false
+			if [[ ${vname} == stats ]] ; then
+				for s in "input bytes" "output bytes" "output write" ; do
+					n=$(stat_of "${tmpdir}/err" ${s})
+					[[ ${n:-0} -gt 0 ]] || ok=false
+				done
+				# regular files are mapped rather than read
+				if [[ ${input} == pipe ]] ; then
+					n=$(stat_of "${tmpdir}/err" input read)
+					[[ ${n:-0} -gt 0 ]] || ok=false
+				fi
+			elif [[ -s ${tmpdir}/err ]] ; then
+				ok=false
+			fi
+			if ${ok} ; then
+				: $((sucs++))
+			else
+				echo "test ${t} variant ${vname} (${input}): FAIL"
+				: $((fails++))
+			fi
+		done
+	done
+	: $((tsts++))
+done
+
+# the discarded content is counted per kind
+t=utf-8=head-only
+${H2T} -stats ${t}.html 2>&1 > /dev/null | grep '^discarded:' \
+	> "${tmpdir}/err"
+for s in "discarded SCRIPT" "discarded STYLE" "discarded META" \
+	"discarded comments"
+do
+	n=$(stat_of "${tmpdir}/err" ${s})
+	if [[ ${n:-0} -gt 0 ]] ; then
+		: $((sucs++))
+	else
+		echo "test ${t} stats ${s}: FAIL"
+		: $((fails++))
+	fi
+done
+: $((tsts++))
+
+echo "${tsts} option tests, ${sucs} success, ${fails} failures"
+
+[[ ${fails} -ne 0 ]] && exit 1
+
+exit 0
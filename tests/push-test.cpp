@@ -0,0 +1,245 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+/*
+ * Checks that the scanner finds the same in pushed input as in input
+ * it reads itself: each document is pushed in chunks of various sizes,
+ * and the tokens htmlparser_yylex() returns, as well as the events
+ * parse_events() reports, must match those of the same document read
+ * from its file.
+ *   usage: push-test <file>.html ...
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sstream>
+#include <fstream>
+
+#include "../html.h"
+#include "../HTMLControl.h"
+#include "../HTMLParser.tab.hh"
+
+typedef html2text::HTMLParser::token token;
+
+/* the chunk sizes, 0 is a random size from 1 to 100 */
+static const size_t chunks[] = { 1, 2, 7, 4096, 0 };
+
+/* feeds a document to an iconvstream opened for push input */
+class Pusher {
+	public:
+		Pusher(iconvstream &is_, const string &data_, size_t chunk_):
+			is(is_),
+			data(data_),
+			chunk(chunk_),
+			pos(0)
+		{
+			srand(1);
+		}
+
+		void feed()
+		{
+			size_t n = chunk != 0 ? chunk : 1 + rand() % 100;
+
+			if (pos == data.length()) {
+				is.push_eof();
+				return;
+			}
+			if (n > data.length() - pos)
+				n = data.length() - pos;
+			is.push(data.data() + pos, n);
+			pos += n;
+		}
+
+	private:
+		iconvstream &is;
+		const string &data;
+		size_t chunk;
+		size_t pos;
+};
+
+/* a few start tags, whose value are their attributes */
+static bool
+has_attributes(int t)
+{
+	return t == token::A || t == token::IMG || t == token::TABLE ||
+		t == token::TD || t == token::FONT || t == token::META ||
+		t == token::P || t == token::DIV || t == token::BODY;
+}
+
+/* write the tokens of the document to out, pulled when pusher is NULL */
+static void
+dump_tokens(HTMLControl &control, Pusher *pusher, std::ostringstream &out)
+{
+	html2text::HTMLParser::semantic_type value;
+
+	for (;;) {
+		int t = control.htmlparser_yylex(&value);
+
+		if (t == HTMLControl::NEED_INPUT) {
+			pusher->feed();
+			continue;
+		}
+		if (t <= 0)
+			break;
+		out << t;
+		if (t == token::PCDATA) {
+			PCData *d = value.pcdata;
+
+			out << " [";
+			if (d->view != NULL)
+				out.write((const char *)d->view, d->viewlen);
+			else
+				out << d->text.c_str();
+			out << "]";
+			delete d;
+		} else if (t == token::SCRIPT || t == token::STYLE) {
+			string cdata;
+			bool ok;
+
+			while (!(ok = control.read_cdata(t == token::SCRIPT ?
+							"</SCRIPT>" : "</STYLE>", &cdata)) &&
+					control.starved())
+				pusher->feed();
+			out << " " << ok << " {" << cdata << "}";
+		}
+		if (has_attributes(t) && value.tag_attributes != NULL) {
+			TagAttributes *a = value.tag_attributes;
+
+			for (int id = 0; id < ATTR_UNKNOWN; id++) {
+				int i = a->find((AttributeName)id);
+
+				if (i >= 0)
+					out << " " << id << "=" << a->raw_value(i);
+			}
+			delete a;
+		}
+		out << " @" << control.current_line << "\n";
+	}
+	out << "EOF @" << control.current_line << "\n";
+}
+
+class Dumper : public SaxHandler {
+	public:
+		Dumper(std::ostringstream &out_):
+			out(out_)
+		{
+		}
+
+		void start_tag(const char *name, size_t namelen,
+				const SaxAttribute *attrs, size_t nattrs)
+		{
+			out << "<";
+			out.write(name, namelen);
+			for (size_t i = 0; i < nattrs; i++) {
+				out << " ";
+				out.write(attrs[i].name, attrs[i].namelen);
+				out << "=[";
+				out.write(attrs[i].value, attrs[i].valuelen);
+				out << "]";
+			}
+			out << ">\n";
+		}
+		void end_tag(const char *name, size_t namelen)
+		{
+			out << "</";
+			out.write(name, namelen);
+			out << ">\n";
+		}
+		void text(const char *text, size_t len)
+		{
+			out << "text [";
+			out.write(text, len);
+			out << "]\n";
+		}
+		void comment(const char *text, size_t len)
+		{
+			out << "comment [";
+			out.write(text, len);
+			out << "]\n";
+		}
+
+	private:
+		std::ostringstream &out;
+};
+
+/* write the events of the document to out, pulled when pusher is NULL */
+static void
+dump_events(HTMLControl &control, Pusher *pusher, std::ostringstream &out)
+{
+	Dumper dumper(out);
+
+	while (control.parse_events(&dumper) == HTMLControl::NEED_INPUT)
+		pusher->feed();
+	out << "EOF @" << control.current_line << "\n";
+}
+
+static string
+run(const char *file, const string &data, size_t chunk, bool events)
+{
+	std::ostringstream out;
+	iconvstream is;
+	int mode = 0;
+	HTMLControl control(is, mode, false, file);
+	Pusher pusher(is, data, chunk);
+
+	if (chunk == (size_t)-1)
+		is.open_is(file, "auto");
+	else
+		is.open_push("auto");
+	if (events)
+		dump_events(control, chunk == (size_t)-1 ? NULL : &pusher, out);
+	else
+		dump_tokens(control, chunk == (size_t)-1 ? NULL : &pusher, out);
+	is.close_is();
+	return out.str();
+}
+
+int
+main(int argc, char *argv[])
+{
+	int fails = 0;
+	int sucs = 0;
+
+	for (int i = 1; i < argc; i++) {
+		std::ifstream f(argv[i], std::ios::binary);
+		std::ostringstream data;
+
+		if (!f) {
+			printf("skipping non-existent test: %s\n", argv[i]);
+			continue;
+		}
+		data << f.rdbuf();
+
+		for (int events = 0; events <= 1; events++) {
+			string pulled = run(argv[i], data.str(), (size_t)-1, events);
+
+			for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+				if (run(argv[i], data.str(), chunks[c], events) == pulled) {
+					sucs++;
+				} else {
+					printf("test push %s %s in chunks of %zu: FAIL\n",
+							argv[i], events ? "events" : "tokens",
+							chunks[c]);
+					fails++;
+				}
+			}
+		}
+	}
+
+	printf("%d push tests, %d success, %d failures\n",
+			sucs + fails, sucs, fails);
+
+	return fails != 0;
+}
@@ -18,6 +18,8 @@ TESTS=( "$@" )
 VARIANTS=(
 	default:""
 	links:"-links"
+	head:"-head"
+	ascii:"-ascii"
 )
 
 [[ ${TEST_APPROVE} -ge 1 ]] && MODE=patch
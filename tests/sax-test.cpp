@@ -0,0 +1,134 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+/*
+ * Checks the events HTMLControl::parse_events() reports for a few
+ * documents against what they should be.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sstream>
+
+#include "../html.h"
+#include "../HTMLControl.h"
+
+/* writes the events, one per line, stops at the text "stop" */
+class Recorder : public SaxHandler {
+	public:
+		void start_tag(const char *name, size_t namelen,
+				const SaxAttribute *attrs, size_t nattrs)
+		{
+			out << "<";
+			out.write(name, namelen);
+			for (size_t i = 0; i < nattrs; i++) {
+				out << " ";
+				out.write(attrs[i].name, attrs[i].namelen);
+				out << "=[";
+				out.write(attrs[i].value, attrs[i].valuelen);
+				out << "]";
+			}
+			out << ">\n";
+		}
+		void end_tag(const char *name, size_t namelen)
+		{
+			out << "</";
+			out.write(name, namelen);
+			out << ">\n";
+		}
+		void text(const char *text, size_t len)
+		{
+			out << "text [";
+			out.write(text, len);
+			out << "]\n";
+			if (len == 4 && memcmp(text, "stop", 4) == 0)
+				stop = true;
+		}
+		void comment(const char *text, size_t len)
+		{
+			out << "comment [";
+			out.write(text, len);
+			out << "]\n";
+		}
+
+		std::ostringstream out;
+};
+
+static const struct {
+	const char *name;
+	const char *html;
+	const char *events;
+} tests[] = {
+	{ "unknown tags",
+		"<p>a<blink>b</blink><x:y.z>c</p>",
+		"<p>\n" "text [a]\n" "<blink>\n" "text [b]\n" "</blink>\n"
+		"<x:y.z>\n" "text [c]\n" "</p>\n" },
+	{ "attributes",
+		"<a href=\"x y\" title='it&amp;s' id=z9 hidden>&lt;t&gt;</a>",
+		"<a href=[x y] title=[it&amp;s] id=[z9] hidden=[]>\n"
+		"text [<t>]\n" "</a>\n" },
+	{ "valueless attribute and empty tag",
+		"<input value=v disabled><br/>",
+		"<input value=[v] disabled=[]>\n" "<br>\n" },
+	{ "comments",
+		"a<!-- one -->b<!---->c",
+		"text [a]\n" "comment [ one ]\n" "text [b]\n" "comment []\n"
+		"text [c]\n" },
+	{ "script and style",
+		"<script type=\"text/javascript\">if (a < b) x = \"</p>\";"
+		"</script><style>p > b { }</style>",
+		"<script type=[text/javascript]>\n"
+		"text [if (a < b) x = \"</p>\";]\n" "</SCRIPT>\n"
+		"<style>\n" "text [p > b { }]\n" "</STYLE>\n" },
+	{ "whitespace kept",
+		"<p>  a\n\tb  </p>",
+		"<p>\n" "text [  a\n\tb  ]\n" "</p>\n" },
+	{ "stop",
+		"<p>one</p><p>stop</p><p>three</p>",
+		"<p>\n" "text [one]\n" "</p>\n" "<p>\n" "text [stop]\n" },
+};
+
+int
+main(void)
+{
+	int fails = 0;
+	int tsts = 0;
+
+	for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+		iconvstream is;
+		int mode = 0;
+		HTMLControl control(is, mode, false, tests[i].name);
+		Recorder recorder;
+		int ret;
+
+		is.open_push("utf-8");
+		is.push(tests[i].html, strlen(tests[i].html));
+		is.push_eof();
+		ret = control.parse_events(&recorder);
+		is.close_is();
+
+		tsts++;
+		if (ret != EOF || recorder.out.str() != tests[i].events) {
+			printf("test sax %s: FAIL\n", tests[i].name);
+			printf("%s", recorder.out.str().c_str());
+			fails++;
+		}
+	}
+
+	printf("%d sax tests, %d success, %d failures\n",
+			tsts, tsts - fails, fails);
+
+	return fails != 0;
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define UTF8_X86 1
+# include <immintrin.h>
+#endif
+
+#include "utf8.h"
+
+/*
+ * Plain byte-by-byte validation.  This follows what glibc's iconv
+ * accepts for UTF-8, so passing input through unconverted gives the same
+ * result: overlong forms and surrogates are rejected, but 4-byte
+ * sequences beyond U+10FFFF are fine.  The 5 and 6-byte forms iconv
+ * also takes are rejected, for they don't fit the int the scanner packs
+ * characters in.
+ * Validation starts at "pos", and continues until the first sequence
+ * boundary at or beyond "stop".
+ */
+static size_t
+utf8_validate_scalar(const unsigned char *buf, size_t len, size_t pos,
+		size_t stop, bool *truncated)
+{
+	while (pos < stop) {
+		unsigned char c = buf[pos];
+		unsigned char lo = 0x80;
+		unsigned char hi = 0xBF;
+		size_t n;
+		size_t i;
+
+		if (c < 0x80) {
+			pos++;
+			continue;
+		}
+
+		if (c >= 0xC2 && c <= 0xDF) {
+			n = 2;
+		} else if (c >= 0xE0 && c <= 0xEF) {
+			n = 3;
+			if (c == 0xE0)
+				lo = 0xA0;
+			else if (c == 0xED)
+				hi = 0x9F;
+		} else if (c >= 0xF0 && c <= 0xF7) {
+			n = 4;
+			if (c == 0xF0)
+				lo = 0x90;
+		} else {
+			return pos;
+		}
+
+		for (i = 1; i < n; i++) {
+			if (pos + i == len) {
+				*truncated = true;
+				return pos;
+			}
+			c = buf[pos + i];
+			if (c < lo || c > hi)
+				return pos;
+			lo = 0x80;
+			hi = 0xBF;
+		}
+		pos += n;
+	}
+
+	return pos;
+}
+
+#ifdef UTF8_X86
+/*
+ * Return the start of the sequence that is cut by offset "pos", or
+ * "pos" itself if no sequence crosses it.  Everything before "pos" is
+ * assumed to be valid, so the scalar code can take over from there
+ * after a vectorised run.
+ */
+static size_t
+utf8_sequence_start(const unsigned char *buf, size_t pos)
+{
+	size_t i;
+
+	for (i = 1; i <= 3 && i <= pos; i++) {
+		unsigned char c = buf[pos - i];
+
+		if (c < 0x80)
+			break;
+		if (c >= 0xC0) {
+			if (i < (c >= 0xF0 ? 4U : c >= 0xE0 ? 3U : 2U))
+				return pos - i;
+			break;
+		}
+	}
+	return pos;
+}
+
+# ifdef __SSE2__
+/*
+ * SSE2 lacks a byte shuffle, so only skip over ASCII in 16-byte strides
+ * and leave the multibyte sequences to the scalar code.
+ */
+static size_t
+utf8_validate_sse2(const unsigned char *buf, size_t len, bool *truncated)
+{
+	size_t pos = 0;
+
+	for (;;) {
+		size_t next;
+
+		while (pos + 16 <= len) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(buf + pos));
+			if (_mm_movemask_epi8(v) != 0)
+				break;
+			pos += 16;
+		}
+		if (pos + 16 > len)
+			break;
+
+		/* check the sequences in this block, and whatever straddles
+		 * its end */
+		next = utf8_validate_scalar(buf, len, pos, pos + 16, truncated);
+		if (next < pos + 16)
+			return next;
+		pos = next;
+	}
+
+	return utf8_validate_scalar(buf, len, pos, len, truncated);
+}
+# endif
+
+/*
+ * Full validation of 32 bytes at a time using the lookup tables
+ * approach from Keiser and Lemire, "Validating UTF-8 In Less Than One
+ * Instruction Per Byte" (2021).  Each byte is classified by its own
+ * high nibble and both nibbles of the byte before it, multibyte length
+ * violations are detected by looking back 2 and 3 bytes.  Once a block
+ * shows an error, the scalar code determines the exact offset.  Since
+ * this rejects everything beyond U+10FFFF, which iconv accepts, the
+ * scalar code may well find the block to be fine, in which case we just
+ * carry on.
+ */
+# define UTF8_TOO_SHORT      (1 << 0)
+# define UTF8_TOO_LONG       (1 << 1)
+# define UTF8_OVERLONG_3     (1 << 2)
+# define UTF8_TOO_LARGE      (1 << 3)
+# define UTF8_SURROGATE      (1 << 4)
+# define UTF8_OVERLONG_2     (1 << 5)
+# define UTF8_TOO_LARGE_1000 (1 << 6)
+# define UTF8_OVERLONG_4     (1 << 6)
+# define UTF8_TWO_CONTS      (1 << 7)
+# define UTF8_CARRY          (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+__attribute__((target("avx2")))
+static inline __m256i
+utf8_prev(__m256i input, __m256i prev_input, const int n)
+{
+	__m256i t = _mm256_permute2x128_si256(prev_input, input, 0x21);
+	switch (n) {
+		case 1:
+			return _mm256_alignr_epi8(input, t, 16 - 1);
+		case 2:
+			return _mm256_alignr_epi8(input, t, 16 - 2);
+		default:
+			return _mm256_alignr_epi8(input, t, 16 - 3);
+	}
+}
+
+__attribute__((target("avx2")))
+static size_t
+utf8_validate_avx2(const unsigned char *buf, size_t len, bool *truncated)
+{
+	const __m256i byte_1_high_tbl = _mm256_setr_epi8(
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+		UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+		UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 |
+			UTF8_OVERLONG_4,
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+		UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+		UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 |
+			UTF8_OVERLONG_4);
+	const __m256i byte_1_low_tbl = _mm256_setr_epi8(
+		UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+		UTF8_CARRY | UTF8_OVERLONG_2,
+		UTF8_CARRY,
+		UTF8_CARRY,
+		UTF8_CARRY | UTF8_TOO_LARGE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+		UTF8_CARRY | UTF8_OVERLONG_2,
+		UTF8_CARRY,
+		UTF8_CARRY,
+		UTF8_CARRY | UTF8_TOO_LARGE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000);
+	const __m256i byte_2_high_tbl = _mm256_setr_epi8(
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS |
+			UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	const __m256i third = _mm256_set1_epi8((char)(0xE0 - 0x80));
+	const __m256i fourth = _mm256_set1_epi8((char)(0xF0 - 0x80));
+	const __m256i high = _mm256_set1_epi8((char)0x80);
+	__m256i prev_input = _mm256_setzero_si256();
+	size_t pos = 0;
+
+	while (pos + 32 <= len) {
+		__m256i input = _mm256_loadu_si256((const __m256i *)(buf + pos));
+
+		if (_mm256_movemask_epi8(input) == 0) {
+			/* pure ASCII is only wrong when the previous block ended
+			 * in an unfinished sequence */
+			if (utf8_sequence_start(buf, pos) == pos) {
+				prev_input = input;
+				pos += 32;
+				continue;
+			}
+		} else {
+			__m256i prev1 = utf8_prev(input, prev_input, 1);
+			__m256i sc = _mm256_and_si256(
+				_mm256_and_si256(
+					_mm256_shuffle_epi8(byte_1_high_tbl,
+						_mm256_and_si256(_mm256_srli_epi16(prev1, 4),
+							nibble)),
+					_mm256_shuffle_epi8(byte_1_low_tbl,
+						_mm256_and_si256(prev1, nibble))),
+				_mm256_shuffle_epi8(byte_2_high_tbl,
+					_mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+			__m256i prev2 = utf8_prev(input, prev_input, 2);
+			__m256i prev3 = utf8_prev(input, prev_input, 3);
+			__m256i must23 = _mm256_or_si256(
+				_mm256_subs_epu8(prev2, third),
+				_mm256_subs_epu8(prev3, fourth));
+			__m256i error = _mm256_xor_si256(
+				_mm256_and_si256(must23, high), sc);
+			if (_mm256_testz_si256(error, error)) {
+				prev_input = input;
+				pos += 32;
+				continue;
+			}
+		}
+
+		/* find out what is wrong, and resume after this block when it
+		 * turns out to be fine after all */
+		size_t next = utf8_validate_scalar(buf, len,
+				utf8_sequence_start(buf, pos), pos + 32, truncated);
+		if (next < pos + 32)
+			return next;
+		pos = next;
+		prev_input = _mm256_loadu_si256((const __m256i *)(buf + pos - 32));
+	}
+
+	return utf8_validate_scalar(buf, len, utf8_sequence_start(buf, pos),
+			len, truncated);
+}
+#endif
+
+#ifdef UTF8_X86
+static bool
+utf8_has_avx2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+}
+#endif
+
+size_t
+utf8_validate(const unsigned char *buf, size_t len, bool *truncated)
+{
+	*truncated = false;
+
+#ifdef UTF8_X86
+	/* set on the first call, which C++11 makes thread-safe, as this
+	 * runs on the read-ahead thread as well */
+	static const bool use_avx2 = utf8_has_avx2();
+
+	if (use_avx2)
+		return utf8_validate_avx2(buf, len, truncated);
+# ifdef __SSE2__
+	return utf8_validate_sse2(buf, len, truncated);
+# endif
+#endif
+
+	return utf8_validate_scalar(buf, len, 0, len, truncated);
+}
+
+size_t
+utf8_invalid_run(const unsigned char *buf, size_t len)
+{
+	size_t pos;
+
+	for (pos = 0; pos < len; pos++) {
+		bool truncated = false;
+
+		/* check just the one sequence starting here */
+		if (utf8_validate_scalar(buf, len, pos, pos + 1, &truncated) > pos ||
+				truncated)
+			break;
+	}
+
+	return pos;
+}
+
+size_t
+utf8_sanitize(unsigned char *buf, size_t len, bool final)
+{
+	size_t pos = 0;
+	bool truncated;
+
+	for (;;) {
+		pos += utf8_validate(buf + pos, len - pos, &truncated);
+		if (pos == len)
+			return 0;
+		if (truncated && !final)
+			return len - pos;
+		buf[pos++] = '?';
+	}
+}
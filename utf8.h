@@ -0,0 +1,48 @@
+/*
+ * Copyright 2020-2022 Fabian Groffen <grobian@gentoo.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License in the file COPYING for more details.
+ */
+
+#ifndef UTF8_H
+#define UTF8_H 1
+
+#include <stddef.h>
+
+/*
+ * Return the length of the longest prefix of "buf" that consists of
+ * complete and valid UTF-8 sequences.  When the prefix ends because the
+ * last sequence in "buf" is cut short, "*truncated" is set to true,
+ * otherwise the byte at the returned offset is invalid (unless the
+ * whole buffer is valid).
+ * Depending on the CPU, this uses AVX2 or SSE2 to check the input in
+ * bulk.
+ */
+extern size_t utf8_validate(const unsigned char *buf, size_t len,
+		bool *truncated);
+
+/*
+ * Return the number of bytes at the start of "buf" that cannot be the
+ * start of a valid UTF-8 sequence, that is, up to where decoding can
+ * resume after an invalid byte.
+ */
+extern size_t utf8_invalid_run(const unsigned char *buf, size_t len);
+
+/*
+ * Replace every byte in "buf" that is not part of a valid UTF-8
+ * sequence with a '?', the way our iconv error handling does.  Returns
+ * the number of bytes at the end of "buf" that form the start of a
+ * sequence that is cut short, these are left alone, unless "final" is
+ * set, in which case they are replaced too.
+ */
+extern size_t utf8_sanitize(unsigned char *buf, size_t len, bool final);
+
+#endif